@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+
+# Cold-cache load time of the bundled instances, plain against gzip and zstd compressed:
+# ./benchmark-compressed-load.sh [cluster file]
+# The page cache is only dropped when running as root; otherwise the timings are warm.
+
+if [ -z "$1" ] ; then
+  CLUSTER=cluster.vcl
+else
+  CLUSTER=$1
+fi
+
+cd ..
+
+PROG=./bin/wf_security_greedy.x
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+FORMATS="plain gz"
+command -v zstd > /dev/null && FORMATS="$FORMATS zst"
+
+if [ ! -w /proc/sys/vm/drop_caches ] ; then
+  echo "warning: cannot drop the page cache, the timings are warm" >&2
+fi
+
+drop_caches() {
+  if [ -w /proc/sys/vm/drop_caches ] ; then
+    sync
+    echo 3 > /proc/sys/vm/drop_caches
+  fi
+}
+
+compress() {
+  case $2 in
+    plain) cp "$1" "$WORK/$(basename "$1")" ;;
+    gz) gzip -c "$1" > "$WORK/$(basename "$1").gz" ;;
+    zst) zstd -q -c "$1" > "$WORK/$(basename "$1").zst" ;;
+  esac
+}
+
+suffix() {
+  [ "$1" = plain ] || echo ".$1"
+}
+
+for TASKS_AND_FILES in input/tasks_and_files/*.dag ; do
+  INSTANCE=$(basename "$TASKS_AND_FILES" .dag)
+  [ -f input/conflict_graph/$INSTANCE.scg ] || continue
+
+  for FORMAT in $FORMATS ; do
+    rm -f "$WORK"/*
+    compress $TASKS_AND_FILES $FORMAT
+    compress input/clouds/$CLUSTER $FORMAT
+    compress input/conflict_graph/$INSTANCE.scg $FORMAT
+    SUFFIX=$(suffix $FORMAT)
+    BYTES=$(cat "$WORK"/* | wc -c)
+
+    drop_caches
+    TIME=$($PROG --tasks_and_files "$WORK/$INSTANCE.dag$SUFFIX" \
+      --cluster "$WORK/$CLUSTER$SUFFIX" \
+      --conflict_graph "$WORK/$INSTANCE.scg$SUFFIX" \
+      --algorithm parse_benchmark \
+      --number_of_iteration 1 \
+      --minloglevel=3 | grep "Loading time:" | awk '{print $3}')
+
+    echo "$INSTANCE $FORMAT $BYTES bytes $TIME s"
+  done
+done
+
+cd shell
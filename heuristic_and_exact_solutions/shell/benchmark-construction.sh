@@ -0,0 +1,45 @@
+#!/usr/bin/env bash
+
+# Time to build one GRCH schedule on synthetic instances of about 500 activations:
+# ./benchmark-construction.sh [virtual machines] [seed]
+# Every trial of an activation on a virtual machine is scheduled in place and rolled back.
+
+if [ -z "$1" ] ; then
+  VIRTUAL_MACHINES=58
+else
+  VIRTUAL_MACHINES=$1
+fi
+
+if [ -z "$2" ] ; then
+  SEED=0
+else
+  SEED=$2
+fi
+
+cd ..
+
+PROG=./bin/wf_security_greedy.x
+GENERATOR=./bin/wf_instance_generator.x
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+for SHAPE in fork_join montage ; do
+  $GENERATOR --output "$WORK/$SHAPE" \
+    --shape $SHAPE \
+    --activations 500 \
+    --virtual_machines $VIRTUAL_MACHINES \
+    --buckets 2 \
+    --conflict_density 0.001 \
+    --seed $SEED > /dev/null
+
+  SECONDS_TAKEN=$($PROG --tasks_and_files "$WORK/$SHAPE.dag" \
+    --cluster "$WORK/$SHAPE.vcl" \
+    --conflict_graph "$WORK/$SHAPE.scg" \
+    --algorithm evaluation_benchmark \
+    --number_of_iteration 1 \
+    --minloglevel=3 | grep "Construction seconds:" | awk '{print $3}')
+
+  echo "$SHAPE 500 activations $((VIRTUAL_MACHINES + 2)) storages $SECONDS_TAKEN s"
+done
+
+cd shell
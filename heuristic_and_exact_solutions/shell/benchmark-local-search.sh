@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+
+# Local search moves per second on synthetic instances of about 500 activations, evaluating every
+# move from the start of the ordering, from the first position it changes and only on the
+# activations it can delay:
+# ./benchmark-local-search.sh [virtual machines] [seed] [rounds]
+
+if [ -z "$1" ] ; then
+  VIRTUAL_MACHINES=58
+else
+  VIRTUAL_MACHINES=$1
+fi
+
+if [ -z "$2" ] ; then
+  SEED=0
+else
+  SEED=$2
+fi
+
+if [ -z "$3" ] ; then
+  ROUNDS=30
+else
+  ROUNDS=$3
+fi
+
+cd ..
+
+PROG=./bin/wf_security_greedy.x
+GENERATOR=./bin/wf_instance_generator.x
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+for SHAPE in fork_join montage ; do
+  $GENERATOR --output "$WORK/$SHAPE" \
+    --shape $SHAPE \
+    --activations 500 \
+    --virtual_machines $VIRTUAL_MACHINES \
+    --buckets 2 \
+    --conflict_density 0.001 \
+    --seed $SEED > /dev/null
+
+  OUTPUT=$($PROG --tasks_and_files "$WORK/$SHAPE.dag" \
+    --cluster "$WORK/$SHAPE.vcl" \
+    --conflict_graph "$WORK/$SHAPE.scg" \
+    --algorithm evaluation_benchmark \
+    --number_of_iteration $ROUNDS \
+    --minloglevel=3)
+
+  FULL=$(echo "$OUTPUT" | grep "Local search moves per second (full):" | awk '{print $7}')
+  SUFFIX=$(echo "$OUTPUT" | grep "Local search moves per second (suffix):" | awk '{print $7}')
+  CONE=$(echo "$OUTPUT" | grep "Local search moves per second (cone):" | awk '{print $7}')
+
+  echo "$SHAPE 500 activations full $FULL suffix $SUFFIX cone $CONE moves/s"
+done
+
+cd shell
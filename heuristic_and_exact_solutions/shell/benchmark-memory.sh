@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+
+# Peak memory after loading synthetic instances with many files and storages:
+# ./benchmark-memory.sh [virtual machines] [seed]
+# The cluster is fixed, so the memory grows with the number of files only.
+
+if [ -z "$1" ] ; then
+  VIRTUAL_MACHINES=58
+else
+  VIRTUAL_MACHINES=$1
+fi
+
+if [ -z "$2" ] ; then
+  SEED=0
+else
+  SEED=$2
+fi
+
+cd ..
+
+PROG=./bin/wf_security_greedy.x
+GENERATOR=./bin/wf_instance_generator.x
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+for ACTIVATIONS in 1000 2500 5000 ; do
+  $GENERATOR --output "$WORK/layered" \
+    --shape layered \
+    --activations $ACTIVATIONS \
+    --virtual_machines $VIRTUAL_MACHINES \
+    --buckets 2 \
+    --conflict_density 0.0001 \
+    --seed $SEED > /dev/null
+
+  FILES=$(awk 'NR == 1 { print $1 + $2; exit }' "$WORK/layered.dag")
+  MEMORY=$($PROG --tasks_and_files "$WORK/layered.dag" \
+    --cluster "$WORK/layered.vcl" \
+    --conflict_graph "$WORK/layered.scg" \
+    --algorithm parse_benchmark \
+    --number_of_iteration 1 \
+    --minloglevel=3 | grep "Peak memory after loading:" | awk '{print $5}')
+
+  echo "$ACTIVATIONS activations $FILES files $((VIRTUAL_MACHINES + 2)) storages $MEMORY MB"
+done
+
+cd shell
@@ -0,0 +1,33 @@
+#!/usr/bin/env bash
+
+# Parse throughput of the bundled instances: ./benchmark-parse.sh [iterations] [cluster file]
+
+if [ -z "$1" ] ; then
+  ITERATIONS=20
+else
+  ITERATIONS=$1
+fi
+
+if [ -z "$2" ] ; then
+  CLUSTER=cluster.vcl
+else
+  CLUSTER=$2
+fi
+
+cd ..
+
+PROG=./bin/wf_security_greedy.x
+
+for TASKS_AND_FILES in input/tasks_and_files/*.dag ; do
+  INSTANCE=$(basename "$TASKS_AND_FILES" .dag)
+  [ -f input/conflict_graph/$INSTANCE.scg ] || continue
+
+  $PROG --tasks_and_files `pwd`/$TASKS_AND_FILES \
+    --cluster `pwd`/input/clouds/$CLUSTER \
+    --conflict_graph `pwd`/input/conflict_graph/$INSTANCE.scg \
+    --algorithm parse_benchmark \
+    --number_of_iteration $ITERATIONS \
+    --minloglevel=3 | grep " MB/s "
+done
+
+cd shell
@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+
+# Synthetic instances of growing size for the scaling tests:
+# ./generate-scaling-instances.sh [output directory] [seed]
+
+if [ -z "$1" ] ; then
+  OUTPUT=temp/scaling
+else
+  OUTPUT=$1
+fi
+
+if [ -z "$2" ] ; then
+  SEED=0
+else
+  SEED=$2
+fi
+
+cd ..
+
+PROG=./bin/wf_instance_generator.x
+
+mkdir -p $OUTPUT
+
+for SHAPE in layered fork_join montage ; do
+  for ACTIVATIONS in 1000 10000 100000 1000000 ; do
+    # About one conflict per activation with the default two files per activation
+    DENSITY=$(awk "BEGIN { print 1.0 / $ACTIVATIONS / 2.0 }")
+
+    $PROG --output $OUTPUT/${SHAPE}_$ACTIVATIONS \
+      --shape $SHAPE \
+      --activations $ACTIVATIONS \
+      --conflict_density $DENSITY \
+      --seed $SEED | tail -1
+  done
+done
+
+cd shell
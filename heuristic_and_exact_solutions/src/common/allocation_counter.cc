@@ -0,0 +1,58 @@
+/**
+ * \file src/common/allocation_counter.cc
+ * \brief Contains the replacement of the global \c operator \c new that counts the allocations
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file replaces the global \c operator \c new and \c operator \c delete when built with
+ * \c WF_SECURITY_COUNT_ALLOCATIONS; the array and \c nothrow forms call these ones. Each thread
+ * counts its own allocations, so the counter is never shared between threads. Without it the
+ * standard operators are kept and no allocation is counted.
+ */
+
+#include "src/common/allocation_counter.h"
+
+#ifdef WF_SECURITY_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+/// The allocations of the thread
+thread_local size_t allocation_count = 0ul;
+
+}  // namespace
+
+size_t AllocationCount() { return allocation_count; }
+
+void *operator new(std::size_t size) {
+    ++allocation_count;
+    if (size == 0ul) {
+        size = 1ul;
+    }
+    // As the standard one, calls the new handler until the memory is found or there is none
+    while (true) {
+        if (auto *pointer = std::malloc(size)) {
+            return pointer;
+        }
+        auto new_handler = std::get_new_handler();
+        if (!new_handler) {
+            throw std::bad_alloc();
+        }
+        new_handler();
+    }
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+#else
+
+size_t AllocationCount() { return 0ul; }
+
+#endif  // WF_SECURITY_COUNT_ALLOCATIONS
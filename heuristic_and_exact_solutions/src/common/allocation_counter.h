@@ -0,0 +1,30 @@
+/**
+ * \file src/common/allocation_counter.h
+ * \brief Contains the \c AllocationCount function
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the allocation count reported by the benchmarks
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_ALLOCATION_COUNTER_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+#ifdef WF_SECURITY_COUNT_ALLOCATIONS
+/// Whether the global \c operator \c new counts the allocations
+constexpr bool kCountAllocations = true;
+#else
+constexpr bool kCountAllocations = false;
+#endif
+
+/// Number of calls of the global \c operator \c new made by the calling thread so far; always
+/// zero unless built with \c WF_SECURITY_COUNT_ALLOCATIONS
+size_t AllocationCount();
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_ALLOCATION_COUNTER_H_
@@ -0,0 +1,192 @@
+/**
+ * \file src/common/byte_source.cc
+ * \brief Contains the \c ByteSource class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods of the \c ByteSource class
+ */
+
+#include "src/common/byte_source.h"
+
+#include <glog/logging.h>
+#include <zlib.h>
+
+#ifdef WF_SECURITY_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+/// Size of the buffer of compressed bytes
+constexpr size_t kInputSize = 1ul << 17;
+
+/// First bytes of a gzip member
+constexpr unsigned char kGzipMagic[] = {0x1f, 0x8b};
+
+/// First bytes of a zstd frame
+constexpr unsigned char kZstdMagic[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+}  // namespace
+
+ByteSource::ByteSource(const std::string &path) : path_(path), input_(kInputSize) {
+    file_ = std::fopen(path.c_str(), "rb");
+
+    if (file_ == nullptr) {
+        LOG(FATAL) << "Input file could not be opened \"" << path << "\"!";
+    }
+
+    FillInput();
+
+    auto starts_with = [this](const unsigned char *magic, size_t size) {
+        return input_end_ >= size && std::memcmp(input_.data(), magic, size) == 0;
+    };
+
+    if (starts_with(kGzipMagic, sizeof(kGzipMagic))) {
+        compression_ = Compression::kGzip;
+        gzip_stream_ = std::make_unique<z_stream_s>();
+        // 16 + MAX_WBITS accepts the gzip header only
+        if (inflateInit2(gzip_stream_.get(), 16 + MAX_WBITS) != Z_OK) {
+            LOG(FATAL) << "Could not start decompressing \"" << path_ << "\"!";
+        }
+    } else if (starts_with(kZstdMagic, sizeof(kZstdMagic))) {
+        compression_ = Compression::kZstd;
+#ifdef WF_SECURITY_WITH_ZSTD
+        zstd_stream_ = ZSTD_createDStream();
+        if (zstd_stream_ == nullptr || ZSTD_isError(ZSTD_initDStream(zstd_stream_))) {
+            LOG(FATAL) << "Could not start decompressing \"" << path_ << "\"!";
+        }
+#else
+        LOG(FATAL) << "\"" << path_ << "\" is zstd compressed, but the program was built without zstd";
+#endif
+    }
+}
+
+ByteSource::~ByteSource() {
+    if (gzip_stream_) {
+        inflateEnd(gzip_stream_.get());
+    }
+#ifdef WF_SECURITY_WITH_ZSTD
+    if (zstd_stream_ != nullptr) {
+        ZSTD_freeDStream(zstd_stream_);
+    }
+#endif
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+bool ByteSource::FillInput() {
+    input_begin_ = 0ul;
+    input_end_ = std::fread(input_.data(), 1ul, input_.size(), file_);
+
+    if (std::ferror(file_)) {
+        LOG(FATAL) << "Could not read \"" << path_ << "\"!";
+    }
+    return input_end_ > 0ul;
+}
+
+size_t ByteSource::Read(char *buffer, size_t size) {
+    switch (compression_) {
+        case Compression::kGzip:
+            return ReadGzip(buffer, size);
+        case Compression::kZstd:
+            return ReadZstd(buffer, size);
+        case Compression::kNone:
+            break;
+    }
+
+    // The first block was read to detect the compression
+    if (input_begin_ < input_end_) {
+        auto read = std::min(size, input_end_ - input_begin_);
+        std::memcpy(buffer, input_.data() + input_begin_, read);
+        input_begin_ += read;
+        return read;
+    }
+    return std::fread(buffer, 1ul, size, file_);
+}
+
+void ByteSource::ReadAll(std::vector<char> &buffer) {
+    auto position = buffer.size();
+
+    for (;;) {
+        if (buffer.size() - position < kInputSize) {
+            buffer.resize(std::max(buffer.size() * 2ul, position + kInputSize));
+        }
+
+        auto read = Read(buffer.data() + position, buffer.size() - position);
+        if (read == 0ul) {
+            break;
+        }
+        position += read;
+    }
+    buffer.resize(position);
+}
+
+size_t ByteSource::ReadGzip(char *buffer, size_t size) {
+    auto *stream = gzip_stream_.get();
+    // zlib counts in unsigned int
+    size = std::min<size_t>(size, std::numeric_limits<unsigned int>::max());
+
+    stream->next_out = reinterpret_cast<Bytef *>(buffer);
+    stream->avail_out = static_cast<unsigned int>(size);
+
+    while (stream->avail_out == size) {
+        if (input_begin_ == input_end_ && !FillInput()) {
+            if (stream->total_in != 0ul) {
+                LOG(FATAL) << "\"" << path_ << "\" ends in the middle of a gzip member";
+            }
+            break;
+        }
+
+        stream->next_in = reinterpret_cast<Bytef *>(input_.data() + input_begin_);
+        stream->avail_in = static_cast<unsigned int>(input_end_ - input_begin_);
+
+        auto result = inflate(stream, Z_NO_FLUSH);
+
+        input_begin_ = input_end_ - stream->avail_in;
+        if (result == Z_STREAM_END) {
+            // Another member may follow
+            inflateReset(stream);
+        } else if (result != Z_OK && result != Z_BUF_ERROR) {
+            LOG(FATAL) << "\"" << path_ << "\" is not a valid gzip file: "
+                       << (stream->msg != nullptr ? stream->msg : "unknown error");
+        }
+    }
+    return size - stream->avail_out;
+}
+
+#ifdef WF_SECURITY_WITH_ZSTD
+size_t ByteSource::ReadZstd(char *buffer, size_t size) {
+    ZSTD_outBuffer output = {buffer, size, 0ul};
+
+    while (output.pos == 0ul) {
+        if (input_begin_ == input_end_ && !FillInput()) {
+            if (zstd_frame_open_) {
+                LOG(FATAL) << "\"" << path_ << "\" ends in the middle of a zstd frame";
+            }
+            break;
+        }
+
+        ZSTD_inBuffer input = {input_.data(), input_end_, input_begin_};
+        auto result = ZSTD_decompressStream(zstd_stream_, &output, &input);
+
+        if (ZSTD_isError(result)) {
+            LOG(FATAL) << "\"" << path_ << "\" is not a valid zstd file: " << ZSTD_getErrorName(result);
+        }
+        input_begin_ = input.pos;
+        zstd_frame_open_ = result != 0ul;
+    }
+    return output.pos;
+}
+#else
+size_t ByteSource::ReadZstd(char *, size_t) {
+    return 0ul;
+}
+#endif
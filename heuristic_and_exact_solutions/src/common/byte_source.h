@@ -0,0 +1,94 @@
+/**
+ * \file src/common/byte_source.h
+ * \brief Contains the \c ByteSource class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c ByteSource class that reads plain, gzip and zstd compressed files
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_BYTE_SOURCE_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_BYTE_SOURCE_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct z_stream_s;
+struct ZSTD_DCtx_s;
+
+/**
+ * \class ByteSource byte_source.h "src/common/byte_source.h"
+ * \brief Reads the bytes of a file, decompressing it on the fly when needed
+ *
+ * The compression is detected from the first bytes of the file, not from its extension. Gzip
+ * files may hold several members and zstd files several frames.
+ */
+class ByteSource {
+public:
+    /// The compression formats recognised
+    enum class Compression { kNone, kGzip, kZstd };
+
+    /// Opens \c path; aborts if it cannot be opened
+    explicit ByteSource(const std::string &path);
+
+    /// Closes the file
+    ~ByteSource();
+
+    ByteSource(const ByteSource &) = delete;
+
+    ByteSource &operator=(const ByteSource &) = delete;
+
+    /// Reads up to \c size decompressed bytes into \c buffer; returns 0 only at the end of the file
+    size_t Read(char *buffer, size_t size);
+
+    /// Reads all the remaining decompressed bytes, appending them to \c buffer
+    void ReadAll(std::vector<char> &buffer);
+
+    /// Getter for compression_
+    [[nodiscard]] Compression get_compression() const { return compression_; }
+
+private:
+    /// Refills \c input_ with compressed bytes; returns false at the end of the file
+    bool FillInput();
+
+    /// Reads from a gzip file
+    size_t ReadGzip(char *buffer, size_t size);
+
+    /// Reads from a zstd file
+    size_t ReadZstd(char *buffer, size_t size);
+
+    /// The name of the file
+    std::string path_;
+
+    /// The file being read
+    std::FILE *file_ = nullptr;
+
+    /// The compression of the file
+    Compression compression_ = Compression::kNone;
+
+    /// Compressed bytes read from the file
+    std::vector<char> input_;
+
+    /// First compressed byte not consumed yet
+    size_t input_begin_ = 0ul;
+
+    /// One past the last compressed byte read
+    size_t input_end_ = 0ul;
+
+    /// The state of zlib, for gzip files
+    std::unique_ptr<z_stream_s> gzip_stream_;
+
+    /// The state of zstd, for zstd files
+    ZSTD_DCtx_s *zstd_stream_ = nullptr;
+
+    /// Whether the last zstd frame was not finished when the input ended
+    bool zstd_frame_open_ = false;
+};
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_BYTE_SOURCE_H_
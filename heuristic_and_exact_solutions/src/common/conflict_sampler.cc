@@ -0,0 +1,96 @@
+/**
+ * \file src/common/conflict_sampler.cc
+ * \brief Contains the \c SampleConflicts function
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the random conflict graph generator
+ */
+
+#include "src/common/conflict_sampler.h"
+
+#include <glog/logging.h>
+
+#include "src/common/seeded_random.h"
+
+/**
+ * Draws every pair of distinct files as a conflict with probability \c density; each conflict is
+ * a hard constraint with probability \c hard_ratio and otherwise a soft constraint with a value in
+ * [1, \c maximum_soft_value].
+ *
+ * The files are split in blocks of rows of the upper triangle holding about the same number of
+ * pairs, one block per thread. The pairs of a row are visited by drawing the gap to the next
+ * conflict from a geometric distribution, so the cost follows the number of conflicts and not
+ * the number of pairs. Every row draws from its own stream of \c seed, which makes the graph
+ * depend only on the seed and not on the number of threads.
+ *
+ * \param[in] file_size           Number of files
+ * \param[in] density             Probability of a conflict between two files
+ * \param[in] hard_ratio          Probability of a conflict being a hard constraint
+ * \param[in] maximum_soft_value  Largest value of a soft constraint
+ * \param[in] seed                Seed of the random numbers
+ * \retval    blocks              The conflicts; value 0 is a hard constraint, as in the .scg files
+ */
+ConflictBlocks SampleConflicts(size_t file_size,
+                               double density,
+                               double hard_ratio,
+                               int maximum_soft_value,
+                               uint64_t seed) {
+    if (!(density >= 0.0 && density <= 1.0)) {
+        LOG(FATAL) << "The conflict density must be in [0, 1], not " << density;
+    }
+    if (!(hard_ratio >= 0.0 && hard_ratio <= 1.0)) {
+        LOG(FATAL) << "The hard conflict ratio must be in [0, 1], not " << hard_ratio;
+    }
+    if (maximum_soft_value < 1) {
+        LOG(FATAL) << "The maximum soft conflict value must be positive, not "
+                   << maximum_soft_value;
+    }
+
+    if (density == 0.0) {
+        file_size = 0ul;
+    }
+
+    auto pair_size = file_size < 2ul ? 0ul : file_size * (file_size - 1ul) / 2ul;
+    auto soft_value_max = static_cast<uint64_t>(maximum_soft_value);
+    auto expected_size = static_cast<size_t>(static_cast<double>(pair_size) * density);
+    auto number_of_blocks = NumberOfWorkers(expected_size, 1ul << 16);
+
+    // Row i holds the pairs (i, j) with j > i; every block gets about the same number of pairs
+    std::vector<size_t> block_begin(number_of_blocks + 1ul, file_size);
+    block_begin[0] = 0ul;
+    for (size_t i = 0ul, pairs = 0ul, block = 1ul; i < file_size && block < number_of_blocks; ++i) {
+        if (pairs >= pair_size * block / number_of_blocks) {
+            block_begin[block++] = i;
+        }
+        pairs += file_size - 1ul - i;
+    }
+
+    ConflictBlocks blocks(number_of_blocks);
+    ParallelFor(number_of_blocks, number_of_blocks, [&](size_t, size_t begin, size_t end) {
+        for (auto block = begin; block < end; ++block) {
+            for (auto i = block_begin[block]; i < block_begin[block + 1ul]; ++i) {
+                SeededRandom random(seed, i);
+
+                for (auto j = i + 1ul; j < file_size; ++j) {
+                    if (density < 1.0) {
+                        j += random.Geometric(density, file_size - j);
+                        if (j == file_size) {
+                            break;
+                        }
+                    }
+
+                    int64_t value = 0;
+                    if (!random.Bernoulli(hard_ratio)) {
+                        value = static_cast<int64_t>(random.Uniform(1ul, soft_value_max));
+                    }
+                    blocks[block].push_back({i, j, value});
+                }
+            }
+        }
+    });
+    return blocks;
+}
@@ -0,0 +1,58 @@
+/**
+ * \file src/common/conflict_sampler.h
+ * \brief Contains the \c SampleConflicts and \c WriteConflictGraph functions
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the random conflict graph generator shared by the solver and by the
+ * instance generator
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_CONFLICT_SAMPLER_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_CONFLICT_SAMPLER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common/instance_image.h"
+#include "src/common/parallel.h"
+#include "src/common/text_writer.h"
+
+/// Conflicts in blocks of consecutive rows of the upper triangle, the blocks in row order
+using ConflictBlocks = std::vector<std::vector<instance_image::ConflictRecord>>;
+
+/// Draws a random conflict graph over \c file_size files; see the source file for the parameters
+ConflictBlocks SampleConflicts(size_t file_size,
+                               double density,
+                               double hard_ratio,
+                               int maximum_soft_value,
+                               uint64_t seed);
+
+/// Writes \c blocks as a .scg file in \c path, \c name(id) giving the name of the file \c id
+template<typename Name>
+void WriteConflictGraph(const std::string &path, const ConflictBlocks &blocks, Name name) {
+    std::vector<std::string> texts(blocks.size());
+
+    auto number_of_workers = NumberOfWorkers(blocks.size());
+
+    ParallelFor(blocks.size(), number_of_workers, [&](size_t, size_t begin, size_t end) {
+        for (auto block = begin; block < end; ++block) {
+            for (const auto &conflict: blocks[block]) {
+                texts[block] += name(conflict.first_file);
+                texts[block] += ' ';
+                texts[block] += name(conflict.second_file);
+                texts[block] += ' ';
+                AppendNumber(texts[block], conflict.value);
+                texts[block] += '\n';
+            }
+        }
+    });
+    WriteTextBlocks(path, texts);
+}
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_CONFLICT_SAMPLER_H_
@@ -0,0 +1,52 @@
+/**
+ * \file src/common/index_types.h
+ * \brief Contains the index and time types of the search core
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the types of the activation, file and storage IDs and of the times
+ * kept in the arrays of the solutions. Building with \c WF_SECURITY_COMPACT_INDEX makes them 32
+ * bits wide; \c Algorithm checks at load that the instance fits.
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_INDEX_TYPES_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_INDEX_TYPES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#ifdef WF_SECURITY_COMPACT_INDEX
+/// An activation, file or storage ID, or a position, as kept by the solutions
+using IndexType = uint32_t;
+
+/// A time as kept by the solutions
+using TimeType = uint32_t;
+#else
+/// An activation, file or storage ID, or a position, as kept by the solutions
+using IndexType = size_t;
+
+/// A time as kept by the solutions
+using TimeType = size_t;
+#endif
+
+/// The missing index or time, as kept by the solutions
+template<typename T>
+constexpr T kNoValue = std::numeric_limits<T>::max();
+
+/// Keep \c value in the type \c T; the maximum \c size_t, the missing value, stays the missing one
+template<typename T>
+constexpr T NarrowIndex(size_t value) {
+    return value == std::numeric_limits<size_t>::max() ? kNoValue<T> : static_cast<T>(value);
+}
+
+/// Take \c value back to \c size_t; the missing value becomes the maximum \c size_t
+template<typename T>
+constexpr size_t WidenIndex(T value) {
+    return value == kNoValue<T> ? std::numeric_limits<size_t>::max() : static_cast<size_t>(value);
+}
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_INDEX_TYPES_H_
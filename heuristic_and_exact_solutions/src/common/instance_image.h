@@ -0,0 +1,122 @@
+/**
+ * \file src/common/instance_image.h
+ * \brief Contains the layout of the binary instance image
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the records of the binary instance image written by the \c compile
+ * mode. The image is a \c Header followed by 8-byte aligned sections; every section is an array of
+ * one record type and its length follows from the counters in the \c Header. Names are stored in
+ * a single pool of characters referenced by (offset, length) pairs.
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_INSTANCE_IMAGE_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_INSTANCE_IMAGE_H_
+
+#include <cstdint>
+
+namespace instance_image {
+
+/// Identifies an instance image file
+constexpr char kMagic[8] = {'W', 'F', 'S', 'E', 'C', 'I', 'M', 'G'};
+
+/// Bumped whenever the layout below changes; images of other versions are rejected
+constexpr uint32_t kVersion = 1u;
+
+/// Written in native byte order; an image from a machine with another byte order is rejected
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+
+/// Sections of the image, in the order they are written
+enum Section : uint32_t {
+    kRequirements,             ///< \c RequirementRecord per requirement
+    kFiles,                    ///< \c FileRecord per file
+    kStaticFileVms,            ///< uint64_t virtual machine IDs referenced by \c FileRecord
+    kActivations,              ///< \c ActivationRecord per activation, source and target included
+    kActivationFiles,          ///< uint64_t file IDs referenced by \c ActivationRecord
+    kActivationRequirements,   ///< int32_t activation_size x requirement_size matrix
+    kSuccessorOffsets,         ///< uint64_t activation_size + 1 offsets into \c kSuccessors
+    kSuccessors,               ///< uint64_t activation IDs
+    kStorages,                 ///< \c StorageRecord per storage, virtual machines first
+    kStorageRequirements,      ///< int32_t storage_size x requirement_size matrix
+    kConflicts,                ///< \c ConflictRecord per conflict
+    kNames,                    ///< Pool of characters
+    kNumberOfSections
+};
+
+/// First bytes of the image
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order_mark;
+    uint64_t image_size;
+    uint64_t static_file_size;
+    uint64_t dynamic_file_size;
+    uint64_t activation_size;
+    uint64_t requirement_size;
+    uint64_t virtual_machine_size;
+    uint64_t bucket_size;
+    uint64_t static_file_vm_size;
+    uint64_t activation_file_size;
+    uint64_t successor_size;
+    uint64_t conflict_size;
+    uint64_t name_size;
+    uint64_t maximum_of_soft_constraints;
+    double makespan_max;
+    double budget_max;
+    uint64_t sections[kNumberOfSections];
+};
+
+/// A \c Requirement
+struct RequirementRecord {
+    uint64_t id;
+    double max_value;
+};
+
+/// A \c StaticFile or a \c DynamicFile; static files own the range [vm_begin, vm_end)
+struct FileRecord {
+    double size_in_MB;
+    uint64_t name_offset;
+    uint64_t name_length;
+    uint64_t vm_begin;
+    uint64_t vm_end;
+};
+
+/// An \c Activation; inputs are [input_begin, output_begin) and outputs [output_begin, output_end)
+struct ActivationRecord {
+    double time;
+    uint64_t tag_offset;
+    uint64_t tag_length;
+    uint64_t name_offset;
+    uint64_t name_length;
+    uint64_t input_begin;
+    uint64_t output_begin;
+    uint64_t output_end;
+};
+
+/// A \c VirtualMachine or a \c Bucket, holding the values given to their constructors
+struct StorageRecord {
+    uint64_t is_bucket;
+    int64_t type_id;
+    double slowdown;
+    double storage;
+    double bandwidth;
+    double cost;
+    uint64_t number_of_intervals;
+    uint64_t name_offset;
+    uint64_t name_length;
+};
+
+/// A line of the conflict graph; value 0 is a hard constraint
+struct ConflictRecord {
+    uint64_t first_file;
+    uint64_t second_file;
+    int64_t value;
+};
+
+}  // namespace instance_image
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_INSTANCE_IMAGE_H_
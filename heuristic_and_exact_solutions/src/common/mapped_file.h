@@ -0,0 +1,81 @@
+/**
+ * \file src/common/mapped_file.h
+ * \brief Contains the \c MappedFile class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c MappedFile class, a read-only memory mapping of a file
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_MAPPED_FILE_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_MAPPED_FILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \class MappedFile mapped_file.h "src/common/mapped_file.h"
+ * \brief Maps a whole file read-only into memory and unmaps it on destruction
+ */
+class MappedFile {
+public:
+    /// Maps \c path; \c is_open() tells whether it succeeded
+    explicit MappedFile(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat status{};
+
+        if (::fstat(fd, &status) == 0 && status.st_size > 0) {
+            void *address = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE,
+                                   fd, 0);
+
+            if (address != MAP_FAILED) {
+                data_ = static_cast<const char *>(address);
+                size_ = static_cast<size_t>(status.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    /// Unmaps the file
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// Whether the file is mapped
+    [[nodiscard]] bool is_open() const { return data_ != nullptr; }
+
+    /// Getter for data_
+    [[nodiscard]] const char *data() const { return data_; }
+
+    /// Getter for size_
+    [[nodiscard]] size_t size() const { return size_; }
+
+private:
+    /// First byte of the mapping
+    const char *data_ = nullptr;
+
+    /// Size of the mapping in bytes
+    size_t size_ = 0ul;
+};
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_MAPPED_FILE_H_
@@ -0,0 +1,30 @@
+/**
+ * \file src/common/memory_usage.h
+ * \brief Contains the \c PeakMemoryInMB function
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the memory measure reported by the benchmarks
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_MEMORY_USAGE_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_MEMORY_USAGE_H_
+
+#include <sys/resource.h>
+
+/// The largest resident set size of the process so far, in MB; zero if it cannot be measured
+inline double PeakMemoryInMB() {
+    struct rusage usage{};
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    // Linux reports kilobytes
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_MEMORY_USAGE_H_
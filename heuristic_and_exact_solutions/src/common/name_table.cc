@@ -0,0 +1,125 @@
+/**
+ * \file src/common/name_table.cc
+ * \brief Contains the \c NameTable class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods of the \c NameTable class
+ */
+
+#include "src/common/name_table.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+/// Size of the blocks of the arena; longer names get a block of their own
+constexpr size_t kBlockSize = 1ul << 16;
+
+/// Number of slots of a new table
+constexpr size_t kMinimumSlotSize = 16ul;
+
+}  // namespace
+
+void NameTable::Reserve(size_t size) {
+    names_.reserve(size);
+    hashes_.reserve(size);
+
+    // Keep the load factor at most 1/2
+    if (size * 2ul > slots_.size()) {
+        size_t slot_size = kMinimumSlotSize;
+        while (slot_size < size * 2ul) {
+            slot_size *= 2ul;
+        }
+        Rehash(slot_size);
+    }
+}
+
+size_t NameTable::Intern(std::string_view name) {
+    if ((names_.size() + 1ul) * 2ul > slots_.size()) {
+        Rehash(std::max(slots_.size() * 2ul, kMinimumSlotSize));
+    }
+
+    auto hash = static_cast<uint64_t>(std::hash<std::string_view>()(name));
+    auto mask = slots_.size() - 1ul;
+
+    for (auto slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1ul) & mask) {
+        if (slots_[slot] == 0u) {
+            if (names_.size() >= std::numeric_limits<uint32_t>::max()) {
+                LOG(FATAL) << "Too many names to intern";
+            }
+            auto id = names_.size();
+            names_.push_back(Store(name));
+            hashes_.push_back(hash);
+            slots_[slot] = static_cast<uint32_t>(id + 1ul);
+            return id;
+        }
+
+        auto id = slots_[slot] - 1ul;
+        if (hashes_[id] == hash && names_[id] == name) {
+            return id;
+        }
+    }
+}
+
+size_t NameTable::Find(std::string_view name) const {
+    if (slots_.empty()) {
+        return kNotFound;
+    }
+
+    auto hash = static_cast<uint64_t>(std::hash<std::string_view>()(name));
+    auto mask = slots_.size() - 1ul;
+
+    for (auto slot = static_cast<size_t>(hash) & mask; slots_[slot] != 0u; slot = (slot + 1ul) & mask) {
+        auto id = slots_[slot] - 1ul;
+        if (hashes_[id] == hash && names_[id] == name) {
+            return id;
+        }
+    }
+    return kNotFound;
+}
+
+std::string_view NameTable::Store(std::string_view name) {
+    char *destination;
+
+    if (name.empty()) {
+        return {};
+    }
+
+    if (name.size() > kBlockSize / 4ul) {
+        // Keep the current block for the short names
+        auto block = std::make_unique<char[]>(name.size());
+        destination = block.get();
+        blocks_.insert(blocks_.end() - (blocks_.empty() ? 0 : 1), std::move(block));
+    } else {
+        if (name.size() > block_free_) {
+            blocks_.push_back(std::make_unique<char[]>(kBlockSize));
+            block_free_ = kBlockSize;
+        }
+        destination = blocks_.back().get() + (kBlockSize - block_free_);
+        block_free_ -= name.size();
+    }
+
+    std::memcpy(destination, name.data(), name.size());
+    return {destination, name.size()};
+}
+
+void NameTable::Rehash(size_t slot_size) {
+    slots_.assign(slot_size, 0u);
+
+    auto mask = slot_size - 1ul;
+    for (size_t id = 0ul; id < names_.size(); ++id) {
+        auto slot = static_cast<size_t>(hashes_[id]) & mask;
+        while (slots_[slot] != 0u) {
+            slot = (slot + 1ul) & mask;
+        }
+        slots_[slot] = static_cast<uint32_t>(id + 1ul);
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * \file src/common/name_table.h
+ * \brief Contains the \c NameTable class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c NameTable class that interns the names read from the input files
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_NAME_TABLE_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_NAME_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * \class NameTable name_table.h "src/common/name_table.h"
+ * \brief Maps names to dense IDs, given in the order the names are first seen
+ *
+ * Every distinct name is copied once into an arena whose blocks never move, so the views returned
+ * by \c get_name() stay valid for the lifetime of the table. The lookup is a flat open-addressing
+ * table with linear probing.
+ */
+class NameTable {
+public:
+    /// Returned by \c Find() for unknown names
+    static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+
+    /// Default constructor
+    NameTable() = default;
+
+    NameTable(const NameTable &) = delete;
+
+    NameTable &operator=(const NameTable &) = delete;
+
+    /// Reserve room for \c size names
+    void Reserve(size_t size);
+
+    /// Return the ID of \c name, adding it with the next ID if it is new
+    size_t Intern(std::string_view name);
+
+    /// Return the ID of \c name, or \c kNotFound
+    [[nodiscard]] size_t Find(std::string_view name) const;
+
+    /// Return the interned copy of the name with ID \c id
+    [[nodiscard]] std::string_view get_name(size_t id) const { return names_[id]; }
+
+    /// Return the number of distinct names
+    [[nodiscard]] size_t size() const { return names_.size(); }
+
+private:
+    /// Copy \c name into the arena
+    std::string_view Store(std::string_view name);
+
+    /// Rebuild the slots with \c slot_size entries
+    void Rehash(size_t slot_size);
+
+    /// The interned names, indexed by their IDs
+    std::vector<std::string_view> names_;
+
+    /// The hash of every name, indexed by their IDs
+    std::vector<uint64_t> hashes_;
+
+    /// ID + 1 of the name in each slot, 0 for an empty slot; the size is a power of two
+    std::vector<uint32_t> slots_;
+
+    /// Blocks of the arena holding the characters of the names
+    std::vector<std::unique_ptr<char[]>> blocks_;
+
+    /// Free characters left in the last block
+    size_t block_free_ = 0ul;
+};
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_NAME_TABLE_H_
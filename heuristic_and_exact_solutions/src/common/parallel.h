@@ -0,0 +1,53 @@
+/**
+ * \file src/common/parallel.h
+ * \brief Contains the \c ParallelFor function
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains helpers to split a range of work among threads
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_PARALLEL_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_PARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/// Number of threads worth using for \c work_size items when each thread should get \c min_block
+inline size_t NumberOfWorkers(size_t work_size, size_t min_block = 1ul) {
+    size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1ul);
+    return std::max<size_t>(std::min(hardware, work_size / std::max<size_t>(min_block, 1ul)), 1ul);
+}
+
+/**
+ * Splits [0, \c work_size) into \c number_of_blocks contiguous blocks and calls
+ * \c function(block, begin, end) for each of them, one block per thread. The calling thread runs
+ * the first block and returns once all of them are done.
+ */
+template<typename Function>
+void ParallelFor(size_t work_size, size_t number_of_blocks, Function function) {
+    number_of_blocks = std::max<size_t>(std::min(number_of_blocks, work_size), 1ul);
+
+    auto begin_of = [work_size, number_of_blocks](size_t block) {
+        return work_size * block / number_of_blocks;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(number_of_blocks - 1ul);
+    for (size_t block = 1ul; block < number_of_blocks; ++block) {
+        workers.emplace_back(function, block, begin_of(block), begin_of(block + 1ul));
+    }
+    function(0ul, begin_of(0ul), begin_of(1ul));
+
+    for (auto &worker: workers) {
+        worker.join();
+    }
+}
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_PARALLEL_H_
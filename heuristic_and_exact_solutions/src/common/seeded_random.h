@@ -0,0 +1,76 @@
+/**
+ * \file src/common/seeded_random.h
+ * \brief Contains the \c SeededRandom class
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains a small reproducible random number generator for the instance
+ * generators
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_SEEDED_RANDOM_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_SEEDED_RANDOM_H_
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * \class SeededRandom seeded_random.h "src/common/seeded_random.h"
+ * \brief SplitMix64 generator split into independent streams
+ *
+ * Every (seed, stream) pair yields its own sequence, so work split by stream among threads draws
+ * the same numbers no matter how many threads there are.
+ */
+class SeededRandom {
+public:
+    /// Starts the sequence of the stream \c stream of \c seed
+    explicit SeededRandom(uint64_t seed, uint64_t stream = 0ul)
+            : state_(Mix(seed + kGamma) ^ Mix(stream * kGamma + 1ul)) {}
+
+    /// Returns the next 64 random bits
+    uint64_t Next() {
+        state_ += kGamma;
+        return Mix(state_);
+    }
+
+    /// Returns a double in [0, 1)
+    double NextDouble() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+
+    /// Returns an integer in [0, \c size); \c size must be positive
+    uint64_t NextBelow(uint64_t size) { return Next() % size; }
+
+    /// Returns an integer in [\c min, \c max]
+    uint64_t Uniform(uint64_t min, uint64_t max) { return min + NextBelow(max - min + 1ul); }
+
+    /// Returns true with probability \c probability
+    bool Bernoulli(double probability) { return NextDouble() < probability; }
+
+    /**
+     * Returns the number of failures before the first success of trials with probability
+     * \c probability, saturated at \c limit; \c probability must be in (0, 1)
+     */
+    uint64_t Geometric(double probability, uint64_t limit) {
+        auto failures = std::floor(std::log1p(-NextDouble()) / std::log1p(-probability));
+        return failures >= static_cast<double>(limit) ? limit : static_cast<uint64_t>(failures);
+    }
+
+private:
+    /// The increment of SplitMix64, the golden ratio in 64 bits
+    static constexpr uint64_t kGamma = 0x9e3779b97f4a7c15ul;
+
+    /// The finaliser of SplitMix64
+    static uint64_t Mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ul;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebul;
+        return z ^ (z >> 31);
+    }
+
+    /// The state of the sequence
+    uint64_t state_;
+};
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_SEEDED_RANDOM_H_
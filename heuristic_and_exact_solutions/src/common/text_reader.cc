@@ -0,0 +1,130 @@
+/**
+ * \file src/common/text_reader.cc
+ * \brief Contains the \c TextReader and \c LineTokenizer class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods of the buffered line reader and of the in-place tokenizer
+ */
+
+#include "src/common/text_reader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+/// Initial size of the buffer; it grows when a line does not fit
+constexpr size_t kBufferSize = 1ul << 16;
+
+/// Whether \c c separates two fields
+bool IsBlank(char c) { return c == ' ' || c == '\t'; }
+
+}  // namespace
+
+TextReader::TextReader(const std::string &path)
+        : path_(path), source_(path), buffer_(kBufferSize) {}
+
+bool TextReader::Fill() {
+    if (eof_) {
+        return false;
+    }
+
+    // Move the partial line to the front, growing the buffer if it takes all of it
+    if (begin_ > 0ul) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0ul;
+    } else if (end_ == buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2ul);
+    }
+
+    auto read = source_.Read(buffer_.data() + end_, buffer_.size() - end_);
+
+    if (read == 0ul) {
+        eof_ = true;
+        return false;
+    }
+    end_ += read;
+    return true;
+}
+
+bool TextReader::NextLine(std::string_view &line) {
+    size_t searched = begin_;
+    const char *line_break;
+
+    while ((line_break = static_cast<const char *>(
+            std::memchr(buffer_.data() + searched, '\n', end_ - searched))) == nullptr) {
+        auto consumed = begin_;
+
+        searched = end_;
+        if (!Fill()) {
+            // The last line may not have a line break
+            if (begin_ == end_) {
+                return false;
+            }
+            line_break = buffer_.data() + end_;
+            break;
+        }
+        searched -= consumed;
+    }
+
+    auto length = static_cast<size_t>(line_break - (buffer_.data() + begin_));
+    line = std::string_view(buffer_.data() + begin_, length);
+    begin_ += std::min(length + 1ul, end_ - begin_);
+
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1ul);
+    }
+    ++line_number_;
+    return true;
+}
+
+std::string_view TextReader::ExpectLine(const char *what) {
+    std::string_view line;
+
+    if (!NextLine(line)) {
+        LOG(FATAL) << path_ << ":" << line_number_ + 1ul << ": expected " << what
+                   << ", found the end of the file";
+    }
+    return line;
+}
+
+std::string_view LineTokenizer::NextToken(const char *what) {
+    while (position_ < line_.size() && IsBlank(line_[position_])) {
+        ++position_;
+    }
+
+    if (position_ == line_.size()) {
+        Fail(what, std::string_view());
+    }
+
+    token_position_ = position_;
+    while (position_ < line_.size() && !IsBlank(line_[position_])) {
+        ++position_;
+    }
+    return line_.substr(token_position_, position_ - token_position_);
+}
+
+bool LineTokenizer::AtEnd() {
+    while (position_ < line_.size() && IsBlank(line_[position_])) {
+        ++position_;
+    }
+    return position_ == line_.size();
+}
+
+void LineTokenizer::Fail(const char *what, std::string_view token) const {
+    auto column = (token.empty() ? position_ : token_position_) + 1ul;
+
+    if (token.empty()) {
+        LOG(FATAL) << path_ << ":" << line_number_ << ":" << column
+                   << ": expected " << what << ", found the end of the line";
+    }
+    LOG(FATAL) << path_ << ":" << line_number_ << ":" << column
+               << ": expected " << what << ", found \"" << token << "\"";
+    std::abort();
+}
@@ -0,0 +1,138 @@
+/**
+ * \file src/common/text_reader.h
+ * \brief Contains the \c TextReader and \c LineTokenizer classes declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the buffered line reader and the in-place tokenizer used by the input
+ * file readers
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_TEXT_READER_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_TEXT_READER_H_
+
+#include <glog/logging.h>
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "src/common/byte_source.h"
+
+/**
+ * \class TextReader text_reader.h "src/common/text_reader.h"
+ * \brief Reads a text file line by line through a reusable buffer
+ *
+ * Gzip and zstd compressed files are decompressed while they are read (see \c ByteSource).
+ * The lines are returned as views into the buffer, so they are only valid until the next call of
+ * \c NextLine().
+ */
+class TextReader {
+public:
+    /// Opens \c path; aborts if it cannot be opened
+    explicit TextReader(const std::string &path);
+
+    TextReader(const TextReader &) = delete;
+
+    TextReader &operator=(const TextReader &) = delete;
+
+    /// Reads the next line without its line break; returns false at the end of the file
+    bool NextLine(std::string_view &line);
+
+    /// Reads the next line and aborts if the file ended; \c what describes the expected line
+    std::string_view ExpectLine(const char *what);
+
+    /// Getter for path_
+    [[nodiscard]] const std::string &get_path() const { return path_; }
+
+    /// Getter for line_number_, the number of the last line returned
+    [[nodiscard]] size_t get_line_number() const { return line_number_; }
+
+private:
+    /// Refills the buffer keeping the bytes not consumed yet; returns false if nothing was read
+    bool Fill();
+
+    /// The name of the file
+    std::string path_;
+
+    /// The file being read
+    ByteSource source_;
+
+    /// The buffer holding the bytes read from the file
+    std::vector<char> buffer_;
+
+    /// First byte not consumed yet
+    size_t begin_ = 0ul;
+
+    /// One past the last byte read
+    size_t end_ = 0ul;
+
+    /// Whether the end of the file was reached
+    bool eof_ = false;
+
+    /// The number of the last line returned
+    size_t line_number_ = 0ul;
+};
+
+/**
+ * \class LineTokenizer text_reader.h "src/common/text_reader.h"
+ * \brief Splits a line into fields separated by blanks, converting them in place
+ *
+ * Malformed or missing fields abort with the file name, line and column of the field.
+ */
+class LineTokenizer {
+public:
+    /// Tokenizes \c line, the line number \c line_number of the file \c path
+    LineTokenizer(const std::string &path, size_t line_number, std::string_view line)
+            : path_(path), line_number_(line_number), line_(line) {}
+
+    /// Tokenizes \c line, the last line read from \c reader
+    LineTokenizer(const TextReader &reader, std::string_view line)
+            : LineTokenizer(reader.get_path(), reader.get_line_number(), line) {}
+
+    /// Returns the next field; \c what describes the expected field
+    std::string_view NextToken(const char *what);
+
+    /// Returns the next field converted to \c T; \c what describes the expected field
+    template<typename T>
+    T Next(const char *what) {
+        auto token = NextToken(what);
+        T value{};
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+
+        if (error != std::errc() || end != token.data() + token.size()) {
+            Fail(what, token);
+        }
+        return value;
+    }
+
+    /// Whether all fields were consumed
+    bool AtEnd();
+
+    /// Aborts reporting \c token as a malformed \c what
+    [[noreturn]] void Fail(const char *what, std::string_view token) const;
+
+private:
+    /// The file the line came from, used for the error messages
+    const std::string &path_;
+
+    /// The number of the line, used for the error messages
+    size_t line_number_;
+
+    /// The line being tokenized
+    std::string_view line_;
+
+    /// Position of the next character to be read
+    size_t position_ = 0ul;
+
+    /// Position of the last field returned
+    size_t token_position_ = 0ul;
+};
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_TEXT_READER_H_
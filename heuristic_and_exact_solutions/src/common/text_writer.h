@@ -0,0 +1,59 @@
+/**
+ * \file src/common/text_writer.h
+ * \brief Contains helpers to write the text input files
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the helpers used by the generators to format numbers and to write
+ * text formatted in blocks by several threads
+ */
+
+#ifndef WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_TEXT_WRITER_H_
+#define WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_TEXT_WRITER_H_
+
+#include <glog/logging.h>
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Appends the shortest decimal form of \c value to \c text
+template<typename T>
+void AppendNumber(std::string &text, T value) {
+    char buffer[32];
+    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(buffer, end);
+}
+
+/// Appends \c value with \c precision decimal places to \c text
+inline void AppendFixed(std::string &text, double value, int precision) {
+    char buffer[64];
+    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                      std::chars_format::fixed, precision);
+    text.append(buffer, end);
+}
+
+/// Writes the blocks of \c blocks one after the other in \c path, replacing it only once done
+inline void WriteTextBlocks(const std::string &path, const std::vector<std::string> &blocks) {
+    auto temporary_file = path + ".tmp";
+    std::ofstream out(temporary_file, std::ios::binary | std::ios::trunc);
+
+    for (const auto &block: blocks) {
+        out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    }
+    out.close();
+
+    if (!out) {
+        LOG(FATAL) << "\"" << temporary_file << "\" could not be written!";
+    }
+    std::filesystem::rename(temporary_file, path);
+}
+
+
+#endif  // WF_SECURITY_APPROXIMATE_SOLUTIONS_SRC_COMMON_TEXT_WRITER_H_
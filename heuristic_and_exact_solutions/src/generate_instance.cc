@@ -0,0 +1,98 @@
+/**
+ * \file src/generate_instance.cc
+ * \brief Synthetic instance generator
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the \c main() function of the generator of synthetic .dag, .vcl and
+ * .scg input files, used by the stress and scaling tests.
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <iostream>
+
+#include "src/generator/instance_generator.h"
+
+DEFINE_string(output, // NOLINT(cert-err58-cpp)
+              "synthetic",
+              "Prefix of the generated files; .dag, .vcl and .scg are appended to it");
+
+DEFINE_uint64(activations, // NOLINT(cert-err58-cpp)
+              1000ul,
+              "Number of activations, without the source and target ones");
+
+DEFINE_string(shape, // NOLINT(cert-err58-cpp)
+              "layered",
+              "Shape of the workflow: layered, fork_join or montage");
+
+DEFINE_uint64(width, // NOLINT(cert-err58-cpp)
+              0ul,
+              "Activations per layer or stage of the layered and fork_join shapes; 0 is the square root "
+              "of the number of activations");
+
+DEFINE_uint64(files_per_activation, // NOLINT(cert-err58-cpp)
+              2ul,
+              "Number of output files of every activation");
+
+DEFINE_uint64(virtual_machines, // NOLINT(cert-err58-cpp)
+              4ul,
+              "Number of virtual machines");
+
+DEFINE_uint64(buckets, // NOLINT(cert-err58-cpp)
+              2ul,
+              "Number of buckets");
+
+DEFINE_double(conflict_density, // NOLINT(cert-err58-cpp)
+              0.001,
+              "Probability of a conflict between two files");
+
+DEFINE_double(hard_conflict_ratio, // NOLINT(cert-err58-cpp)
+              0.2,
+              "Probability of a conflict being a hard constraint");
+
+DEFINE_int32(maximum_soft_conflict_value, // NOLINT(cert-err58-cpp)
+             1,
+             "Largest value of a soft constraint");
+
+DEFINE_uint64(seed, // NOLINT(cert-err58-cpp)
+              0ul,
+              "Seed of the random numbers; the same flags and seed give the same files");
+
+/**
+ * The \c main() function generates the instance described by the flags and writes its three input
+ * files.
+ */
+int main(int argc, char **argv) {
+    ::google::InitGoogleLogging(argv[0]);
+
+    gflags::SetUsageMessage("generates synthetic .dag, .vcl and .scg input files");
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    InstanceGenerator generator(FLAGS_activations,
+                                InstanceGenerator::ParseShape(FLAGS_shape),
+                                FLAGS_width,
+                                FLAGS_files_per_activation,
+                                FLAGS_virtual_machines,
+                                FLAGS_buckets,
+                                FLAGS_seed);
+
+    generator.WriteTasksAndFiles(FLAGS_output + ".dag");
+    generator.WriteCluster(FLAGS_output + ".vcl");
+    generator.WriteConflictGraph(FLAGS_output + ".scg",
+                                 FLAGS_conflict_density,
+                                 FLAGS_hard_conflict_ratio,
+                                 FLAGS_maximum_soft_conflict_value);
+
+    std::cout << "Number of activations: " << FLAGS_activations << std::endl;
+    std::cout << "Number of files: " << generator.GetFileSize() << std::endl;
+    std::cout << "Instance written in " << FLAGS_output << ".{dag,vcl,scg}" << std::endl;
+
+    gflags::ShutDownCommandLineFlags();
+
+    return 0;
+}
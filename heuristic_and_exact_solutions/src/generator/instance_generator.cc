@@ -0,0 +1,522 @@
+/**
+ * \file src/generator/instance_generator.cc
+ * \brief Contains the \c InstanceGenerator class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods of the \c InstanceGenerator class
+ */
+
+#include "src/generator/instance_generator.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#include "src/common/conflict_sampler.h"
+#include "src/common/parallel.h"
+#include "src/common/text_writer.h"
+
+namespace {
+
+/// The virtual machine types of the bundled clusters
+struct VirtualMachineType {
+    int id;
+    const char *name;
+    double slowdown;
+    double storage_in_GB;
+    double bandwidth;
+    double cost_per_hour;
+};
+
+constexpr VirtualMachineType kVirtualMachineTypes[] = {
+        {0, "m3.medium", 1.53, 80.0, 4.0, 0.02},
+        {1, "m3.large", 0.77, 120.0, 9.0, 0.09},
+        {2, "m3.xlarge", 0.38, 160.0, 10.0, 0.16},
+        {3, "m3.2xlarge", 0.19, 200.0, 10.0, 0.33},
+};
+
+constexpr size_t kNumberOfVirtualMachineTypes = std::size(kVirtualMachineTypes);
+
+/// The largest slowdown, used to bound the makespan
+constexpr double kMaximumSlowdown = 1.53;
+
+/// Number of requirements of every instance; activations get 0 or 1 and storages 1 in each of them
+constexpr size_t kRequirementSize = 2ul;
+
+/// The activations processed by each block when the text is formatted in parallel
+constexpr size_t kBlockSize = 1ul << 14;
+
+/// Appends the tag of the activation \c id to \c text
+void AppendTag(std::string &text, size_t id) {
+    text += 't';
+    AppendNumber(text, id);
+}
+
+/// Returns \c value rounded to two decimal places
+double Round(double value) { return std::round(value * 100.0) / 100.0; }
+
+}  // namespace
+
+InstanceGenerator::Shape InstanceGenerator::ParseShape(const std::string &name) {
+    if (name == "layered") {
+        return Shape::kLayered;
+    } else if (name == "fork_join") {
+        return Shape::kForkJoin;
+    } else if (name == "montage") {
+        return Shape::kMontage;
+    }
+    LOG(FATAL) << "Unknown workflow shape \"" << name << "\"; use layered, fork_join or montage";
+    return Shape::kLayered;
+}
+
+/**
+ * Builds the activations and their files. The activations are numbered so that every parent comes
+ * before its children.
+ *
+ * \param[in] activation_size       Number of activations, without the source and target ones
+ * \param[in] shape                 Shape of the workflow
+ * \param[in] width                 Activations per layer or stage; 0 is the square root of
+ *                                  \c activation_size
+ * \param[in] files_per_activation  Number of output files of every activation
+ * \param[in] virtual_machine_size  Number of virtual machines
+ * \param[in] bucket_size           Number of buckets
+ * \param[in] seed                  Seed of the random numbers
+ */
+InstanceGenerator::InstanceGenerator(size_t activation_size,
+                                     Shape shape,
+                                     size_t width,
+                                     size_t files_per_activation,
+                                     size_t virtual_machine_size,
+                                     size_t bucket_size,
+                                     uint64_t seed)
+        : activation_size_(activation_size),
+          width_(width),
+          files_per_activation_(files_per_activation),
+          virtual_machine_size_(virtual_machine_size),
+          bucket_size_(bucket_size),
+          seed_(seed),
+          // The conflict graph draws its rows from the first streams of the seed
+          random_(seed, std::numeric_limits<uint64_t>::max()) {
+    if (activation_size_ == 0ul) {
+        LOG(FATAL) << "The instance needs at least one activation";
+    }
+    if (files_per_activation_ == 0ul) {
+        LOG(FATAL) << "Every activation needs at least one output file";
+    }
+    if (virtual_machine_size_ == 0ul) {
+        LOG(FATAL) << "The cluster needs at least one virtual machine";
+    }
+    if (width_ == 0ul) {
+        width_ = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(activation_size_))));
+    }
+
+    activation_names_.reserve(activation_size_);
+    parent_offsets_.reserve(activation_size_ + 1ul);
+    parent_offsets_.push_back(0ul);
+
+    switch (shape) {
+        case Shape::kLayered:
+            BuildLayered();
+            break;
+        case Shape::kForkJoin:
+            BuildForkJoin();
+            break;
+        case Shape::kMontage:
+            BuildMontage();
+            break;
+    }
+    BuildFiles();
+}
+
+void InstanceGenerator::AddActivation(const char *name, size_t begin, size_t end) {
+    activation_names_.push_back(name);
+    for (auto parent = begin; parent < end; ++parent) {
+        parents_.push_back(parent);
+    }
+    parent_offsets_.push_back(parents_.size());
+}
+
+void InstanceGenerator::AddActivationWithRandomParents(const char *name,
+                                                       size_t begin,
+                                                       size_t end,
+                                                       size_t maximum) {
+    auto first = parents_.size();
+    auto size = random_.Uniform(1ul, std::min(maximum, end - begin));
+
+    activation_names_.push_back(name);
+    while (parents_.size() - first < size) {
+        auto parent = begin + random_.NextBelow(end - begin);
+        if (std::find(parents_.begin() + static_cast<std::ptrdiff_t>(first), parents_.end(), parent)
+            == parents_.end()) {
+            parents_.push_back(parent);
+        }
+    }
+    parent_offsets_.push_back(parents_.size());
+}
+
+void InstanceGenerator::AddActivation(const char *name, const std::vector<size_t> &parents) {
+    activation_names_.push_back(name);
+    parents_.insert(parents_.end(), parents.begin(), parents.end());
+    parent_offsets_.push_back(parents_.size());
+}
+
+void InstanceGenerator::BuildLayered() {
+    for (size_t begin = 0ul; begin < activation_size_; begin += width_) {
+        auto end = std::min(begin + width_, activation_size_);
+
+        for (auto i = begin; i < end; ++i) {
+            if (begin == 0ul) {
+                AddActivation("task", 0ul, 0ul);
+            } else {
+                AddActivationWithRandomParents("task", begin - width_, begin, 3ul);
+            }
+        }
+    }
+}
+
+void InstanceGenerator::BuildForkJoin() {
+    size_t fork = 0ul;
+
+    AddActivation("fork", 0ul, 0ul);
+    while (activation_names_.size() < activation_size_) {
+        auto begin = activation_names_.size();
+        auto end = std::min(begin + width_, activation_size_);
+
+        for (auto i = begin; i < end; ++i) {
+            AddActivation("branch", fork, fork + 1ul);
+        }
+        if (end < activation_size_) {
+            fork = end;
+            AddActivation("join", begin, end);
+        }
+    }
+}
+
+/**
+ * The levels of Montage: every image is projected, the overlapping projections are compared, the
+ * differences are fitted into one background model, the background of every projection is
+ * corrected and the corrected images are added, shrunk and converted. For \c n images there are
+ * 2n + d + 6 activations, where d is the number of differences, about 2n.
+ */
+void InstanceGenerator::BuildMontage() {
+    if (activation_size_ < 8ul) {
+        LOG(FATAL) << "The montage shape needs at least 8 activations";
+    }
+
+    auto image_size = std::max<size_t>((activation_size_ - 6ul) / 4ul, 1ul);
+    auto difference_size = activation_size_ - 6ul - 2ul * image_size;
+
+    for (size_t i = 0ul; i < image_size; ++i) {
+        AddActivation("mProjectPP", 0ul, 0ul);
+    }
+
+    // The k-th difference compares an image with the one (k / n + 1) images after it
+    auto difference_begin = activation_names_.size();
+    for (size_t k = 0ul; k < difference_size; ++k) {
+        auto first = k % image_size;
+        auto second = (first + 1ul + k / image_size) % image_size;
+
+        if (first == second) {
+            AddActivation("mDiffFit", first, first + 1ul);
+        } else {
+            AddActivation("mDiffFit", {std::min(first, second), std::max(first, second)});
+        }
+    }
+
+    auto concat = activation_names_.size();
+    if (difference_size > 0ul) {
+        AddActivation("mConcatFit", difference_begin, concat);
+    } else {
+        AddActivation("mConcatFit", 0ul, image_size);
+    }
+
+    auto background_model = activation_names_.size();
+    AddActivation("mBgModel", concat, concat + 1ul);
+
+    auto background_begin = activation_names_.size();
+    for (size_t i = 0ul; i < image_size; ++i) {
+        AddActivation("mBackground", {i, background_model});
+    }
+
+    auto table = activation_names_.size();
+    AddActivation("mImgtbl", background_begin, table);
+    AddActivation("mAdd", table, table + 1ul);
+    AddActivation("mShrink", table + 1ul, table + 2ul);
+    AddActivation("mJPEG", table + 2ul, table + 3ul);
+}
+
+/**
+ * Every activation reads one random output of each parent; an activation without parents reads
+ * its own static file instead. The static files come first, so the dynamic files are only
+ * numbered once the number of activations without parents is known.
+ */
+void InstanceGenerator::BuildFiles() {
+    for (size_t i = 0ul; i < activation_size_; ++i) {
+        if (parent_offsets_[i] == parent_offsets_[i + 1ul]) {
+            ++static_file_size_;
+        }
+    }
+    dynamic_file_size_ = activation_size_ * files_per_activation_;
+
+    input_offsets_.reserve(activation_size_ + 1ul);
+    input_offsets_.push_back(0ul);
+    inputs_.reserve(std::max(parents_.size(), static_file_size_));
+    for (size_t i = 0ul, static_file = 0ul; i < activation_size_; ++i) {
+        if (parent_offsets_[i] == parent_offsets_[i + 1ul]) {
+            inputs_.push_back(static_file++);
+        }
+        for (auto p = parent_offsets_[i]; p < parent_offsets_[i + 1ul]; ++p) {
+            auto output = random_.NextBelow(files_per_activation_);
+            inputs_.push_back(static_file_size_ + parents_[p] * files_per_activation_ + output);
+        }
+        input_offsets_.push_back(inputs_.size());
+    }
+
+    times_.resize(activation_size_);
+    requirements_.resize(activation_size_ * kRequirementSize);
+    for (size_t i = 0ul; i < activation_size_; ++i) {
+        times_[i] = Round(1.0 + 99.0 * random_.NextDouble());
+        for (size_t r = 0ul; r < kRequirementSize; ++r) {
+            requirements_[i * kRequirementSize + r] = static_cast<int>(random_.NextBelow(2ul));
+        }
+    }
+
+    file_sizes_.resize(GetFileSize());
+    for (auto &size: file_sizes_) {
+        size = Round(0.1 + 99.9 * random_.NextDouble());
+    }
+
+    static_file_vms_.resize(static_file_size_);
+    for (auto &vm: static_file_vms_) {
+        vm = random_.NextBelow(virtual_machine_size_);
+    }
+}
+
+std::string InstanceGenerator::GetFileName(size_t id) const {
+    std::string name("f");
+    AppendNumber(name, id);
+    return name;
+}
+
+/**
+ * The files and the activations are formatted by several threads, in blocks of consecutive
+ * activations.
+ *
+ * \param[in] path  Name of the .dag file
+ */
+void InstanceGenerator::WriteTasksAndFiles(const std::string &path) const {
+    auto number_of_blocks = (activation_size_ + kBlockSize - 1ul) / kBlockSize;
+    double makespan_max = 0.0;
+
+    for (auto time: times_) {
+        makespan_max += time * kMaximumSlowdown;
+    }
+
+    double cost_per_hour = 0.0;
+    for (size_t i = 0ul; i < virtual_machine_size_; ++i) {
+        cost_per_hour += kVirtualMachineTypes[i % kNumberOfVirtualMachineTypes].cost_per_hour;
+    }
+
+    // The children, to write the successors of every activation
+    std::vector<size_t> child_offsets(activation_size_ + 1ul, 0ul);
+    std::vector<size_t> children(parents_.size());
+    for (auto parent: parents_) {
+        ++child_offsets[parent + 1ul];
+    }
+    for (size_t i = 0ul; i < activation_size_; ++i) {
+        child_offsets[i + 1ul] += child_offsets[i];
+    }
+    std::vector<size_t> next_child(child_offsets.begin(), child_offsets.end() - 1);
+    for (size_t i = 0ul; i < activation_size_; ++i) {
+        for (auto p = parent_offsets_[i]; p < parent_offsets_[i + 1ul]; ++p) {
+            children[next_child[parents_[p]]++] = i;
+        }
+    }
+
+    // Header, requirements, files, activations and successors
+    std::vector<std::string> texts(3ul * number_of_blocks + 1ul);
+    auto &header = texts[0];
+    AppendNumber(header, static_file_size_);
+    header += ' ';
+    AppendNumber(header, dynamic_file_size_);
+    header += ' ';
+    AppendNumber(header, activation_size_);
+    header += ' ';
+    AppendNumber(header, kRequirementSize);
+    header += ' ';
+    AppendFixed(header, std::ceil(makespan_max), 2);
+    header += ' ';
+    AppendFixed(header, std::ceil(makespan_max / 3600.0 * cost_per_hour * 100.0) / 100.0, 2);
+    header += "\n\n";
+    for (size_t r = 0ul; r < kRequirementSize; ++r) {
+        AppendNumber(header, r);
+        header += " 1\n";
+    }
+    header += '\n';
+
+    auto number_of_workers = NumberOfWorkers(number_of_blocks);
+
+    ParallelFor(number_of_blocks, number_of_workers, [&](size_t, size_t begin, size_t end) {
+        for (auto block = begin; block < end; ++block) {
+            auto first = block * kBlockSize;
+            auto last = std::min(first + kBlockSize, activation_size_);
+            auto &files = texts[1ul + block];
+            auto &activations = texts[1ul + number_of_blocks + block];
+            auto &successors = texts[1ul + 2ul * number_of_blocks + block];
+
+            // The static files of the block are the ones read by its activations without parents
+            for (auto i = first; i < last; ++i) {
+                if (parent_offsets_[i] == parent_offsets_[i + 1ul]) {
+                    auto id = inputs_[input_offsets_[i]];
+                    files += GetFileName(id);
+                    files += ' ';
+                    AppendFixed(files, file_sizes_[id], 2);
+                    files += " 1 ";
+                    AppendNumber(files, static_file_vms_[id]);
+                    files += '\n';
+                }
+            }
+
+            for (auto i = first; i < last; ++i) {
+                AppendTag(activations, i);
+                activations += ' ';
+                activations += activation_names_[i];
+                activations += ' ';
+                AppendFixed(activations, times_[i], 2);
+                activations += ' ';
+                AppendNumber(activations, input_offsets_[i + 1ul] - input_offsets_[i]);
+                activations += ' ';
+                AppendNumber(activations, files_per_activation_);
+                for (size_t r = 0ul; r < kRequirementSize; ++r) {
+                    activations += ' ';
+                    AppendNumber(activations, requirements_[i * kRequirementSize + r]);
+                }
+                activations += '\n';
+                for (auto f = input_offsets_[i]; f < input_offsets_[i + 1ul]; ++f) {
+                    activations += GetFileName(inputs_[f]);
+                    activations += '\n';
+                }
+                for (size_t f = 0ul; f < files_per_activation_; ++f) {
+                    activations += GetFileName(static_file_size_ + i * files_per_activation_ + f);
+                    activations += '\n';
+                }
+
+                AppendTag(successors, i);
+                successors += ' ';
+                AppendNumber(successors, child_offsets[i + 1ul] - child_offsets[i]);
+                successors += '\n';
+                for (auto c = child_offsets[i]; c < child_offsets[i + 1ul]; ++c) {
+                    AppendTag(successors, children[c]);
+                    successors += '\n';
+                }
+            }
+        }
+    });
+
+    // The dynamic files follow the static ones, so they close the last block of files
+    auto &dynamic_files = texts[number_of_blocks];
+    for (auto id = static_file_size_; id < GetFileSize(); ++id) {
+        dynamic_files += GetFileName(id);
+        dynamic_files += ' ';
+        AppendFixed(dynamic_files, file_sizes_[id], 2);
+        dynamic_files += '\n';
+    }
+    dynamic_files += '\n';
+    texts[2ul * number_of_blocks] += '\n';
+
+    WriteTextBlocks(path, texts);
+}
+
+/**
+ * Writes a single provider with the virtual machine types of the bundled clusters, in turn, and
+ * standard buckets. The disks of the virtual machines grow with the instance so that together
+ * they can hold every file twice.
+ *
+ * \param[in] path  Name of the .vcl file
+ */
+void InstanceGenerator::WriteCluster(const std::string &path) const {
+    double file_size_in_GB = 0.0;
+    for (auto size: file_sizes_) {
+        file_size_in_GB += size / 1024.0;
+    }
+    auto minimum_storage = std::ceil(2.0 * file_size_in_GB
+                                     / static_cast<double>(virtual_machine_size_));
+
+    std::vector<std::string> texts(1ul);
+    auto &text = texts[0];
+    text += "1 ";
+    AppendNumber(text, kRequirementSize);
+    text += "\n\n55 Synthetic 1 ";
+    AppendNumber(text, virtual_machine_size_);
+    text += ' ';
+    AppendNumber(text, virtual_machine_size_);
+    text += ' ';
+    AppendNumber(text, bucket_size_);
+    text += '\n';
+
+    for (size_t i = 0ul; i < virtual_machine_size_; ++i) {
+        const auto &type = kVirtualMachineTypes[i % kNumberOfVirtualMachineTypes];
+
+        AppendNumber(text, type.id);
+        text += ' ';
+        text += type.name;
+        text += ' ';
+        AppendFixed(text, type.slowdown, 2);
+        text += ' ';
+        AppendFixed(text, std::max(type.storage_in_GB, minimum_storage), 0);
+        text += ' ';
+        AppendFixed(text, type.bandwidth, 1);
+        text += ' ';
+        AppendFixed(text, type.cost_per_hour, 2);
+        for (size_t r = 0ul; r < kRequirementSize; ++r) {
+            text += " 1";
+        }
+        text += '\n';
+    }
+
+    for (size_t i = 0ul; i < bucket_size_; ++i) {
+        AppendNumber(text, 13ul + i);
+        text += " Standard 51200 25.0 0.023";
+        for (size_t r = 0ul; r < kRequirementSize; ++r) {
+            text += " 1";
+        }
+        text += '\n';
+    }
+
+    WriteTextBlocks(path, texts);
+}
+
+/**
+ * Static files cannot move, so a hard constraint between two static files on the same virtual
+ * machine would leave the instance without a feasible schedule; those become soft constraints.
+ *
+ * \param[in] path                Name of the .scg file
+ * \param[in] density             Probability of a conflict between two files
+ * \param[in] hard_ratio          Probability of a conflict being a hard constraint
+ * \param[in] maximum_soft_value  Largest value of a soft constraint
+ */
+void InstanceGenerator::WriteConflictGraph(const std::string &path,
+                                           double density,
+                                           double hard_ratio,
+                                           int maximum_soft_value) const {
+    auto blocks = SampleConflicts(GetFileSize(), density, hard_ratio, maximum_soft_value, seed_);
+
+    for (auto &block: blocks) {
+        for (auto &conflict: block) {
+            if (conflict.value == 0
+                && conflict.second_file < static_file_size_
+                && static_file_vms_[conflict.first_file] == static_file_vms_[conflict.second_file]) {
+                conflict.value = 1;
+            }
+        }
+    }
+
+    ::WriteConflictGraph(path, blocks, [this](size_t id) { return GetFileName(id); });
+}
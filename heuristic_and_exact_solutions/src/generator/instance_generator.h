@@ -0,0 +1,148 @@
+/**
+ * \file src/generator/instance_generator.h
+ * \brief Contains the \c InstanceGenerator class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c InstanceGenerator class, which builds synthetic instances of
+ * any size and writes them as .dag, .vcl and .scg input files
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_GENERATOR_INSTANCE_GENERATOR_H_
+#define APPROXIMATE_SOLUTIONS_SRC_GENERATOR_INSTANCE_GENERATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common/seeded_random.h"
+
+/**
+ * \class InstanceGenerator instance_generator.h "src/generator/instance_generator.h"
+ * \brief Builds a synthetic workflow and its cluster, deterministic from a seed
+ *
+ * Every activation writes \c files_per_activation dynamic files and reads one output of each of
+ * its parents; the activations without parents read a static file each instead. The activation
+ * requirements never exceed the ones of the storages, so every instance has a feasible schedule.
+ */
+class InstanceGenerator {
+public:
+    /// The shapes of the generated workflows
+    enum class Shape {
+        kLayered,   ///< Layers of \c width activations with up to three parents in the layer above
+        kForkJoin,  ///< Stages of \c width parallel activations joined by a single activation
+        kMontage    ///< The levels of the Montage workflow: project, diff, fit, background, add...
+    };
+
+    /// Returns the shape named \c name; aborts on unknown names
+    static Shape ParseShape(const std::string &name);
+
+    /// Builds an instance of \c activation_size activations, without the source and target ones
+    InstanceGenerator(size_t activation_size,
+                      Shape shape,
+                      size_t width,
+                      size_t files_per_activation,
+                      size_t virtual_machine_size,
+                      size_t bucket_size,
+                      uint64_t seed);
+
+    /// Write the activations and files as a .dag file
+    void WriteTasksAndFiles(const std::string &path) const;
+
+    /// Write the virtual machines and buckets as a .vcl file
+    void WriteCluster(const std::string &path) const;
+
+    /// Write a random conflict graph among the files as a .scg file
+    void WriteConflictGraph(const std::string &path,
+                            double density,
+                            double hard_ratio,
+                            int maximum_soft_value) const;
+
+    /// Getter for the number of files, static and dynamic
+    [[nodiscard]] size_t GetFileSize() const { return static_file_size_ + dynamic_file_size_; }
+
+private:
+    /// Add the next activation, named \c name, with the parents in [\c begin, \c end)
+    void AddActivation(const char *name, size_t begin, size_t end);
+
+    /// Add the next activation, named \c name, with 1 to \c maximum parents in [\c begin, \c end)
+    void AddActivationWithRandomParents(const char *name, size_t begin, size_t end, size_t maximum);
+
+    /// Add the next activation, named \c name, with the parents in \c parents
+    void AddActivation(const char *name, const std::vector<size_t> &parents);
+
+    /// Build the activations of a layered workflow
+    void BuildLayered();
+
+    /// Build the activations of a fork-join workflow
+    void BuildForkJoin();
+
+    /// Build the activations of a Montage-like workflow
+    void BuildMontage();
+
+    /// Draw the input files, the sizes and the times once the activations are built
+    void BuildFiles();
+
+    /// Return the name of the file \c id
+    [[nodiscard]] std::string GetFileName(size_t id) const;
+
+    /// Number of activations, without the source and target ones
+    size_t activation_size_;
+
+    /// Number of activations per layer or stage
+    size_t width_;
+
+    /// Number of output files of every activation
+    size_t files_per_activation_;
+
+    /// Number of virtual machines
+    size_t virtual_machine_size_;
+
+    /// Number of buckets
+    size_t bucket_size_;
+
+    /// Seed of the random numbers
+    uint64_t seed_;
+
+    /// The random numbers drawn while building the instance
+    SeededRandom random_;
+
+    /// Number of static files
+    size_t static_file_size_ = 0ul;
+
+    /// Number of dynamic files
+    size_t dynamic_file_size_ = 0ul;
+
+    /// Name of every activation, one of a few fixed names
+    std::vector<const char *> activation_names_;
+
+    /// Parents of activation i are [parent_offsets_[i], parent_offsets_[i + 1]) of \c parents_
+    std::vector<size_t> parent_offsets_;
+
+    /// The parents of all activations
+    std::vector<size_t> parents_;
+
+    /// Input files of activation i are [input_offsets_[i], input_offsets_[i + 1]) of \c inputs_
+    std::vector<size_t> input_offsets_;
+
+    /// The input files of all activations
+    std::vector<size_t> inputs_;
+
+    /// The time of every activation, in seconds
+    std::vector<double> times_;
+
+    /// The requirement values of every activation, two per activation
+    std::vector<int> requirements_;
+
+    /// The size of every file, in MB
+    std::vector<double> file_sizes_;
+
+    /// The virtual machine holding every static file
+    std::vector<size_t> static_file_vms_;
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_GENERATOR_INSTANCE_GENERATOR_H_
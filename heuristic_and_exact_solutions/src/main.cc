@@ -12,6 +12,10 @@
  */
 
 #include <glog/logging.h>
+
+#include <chrono>
+#include "src/common/memory_usage.h"
+
 #include "src/solution/algorithm.h"
 
 DEFINE_string(tasks_and_files, // NOLINT(cert-err58-cpp)
@@ -26,6 +30,34 @@ DEFINE_string(conflict_graph, // NOLINT(cert-err58-cpp)
               "CyberShake_30.xml.scg",
               "Conflict Graph configuration file");
 
+DEFINE_string(instance_image, // NOLINT(cert-err58-cpp)
+              "",
+              "Binary instance image written by the compile algorithm and loaded instead of the text files");
+
+DEFINE_bool(generate_conflict_graph, // NOLINT(cert-err58-cpp)
+            false,
+            "Generate a random conflict graph over the files instead of reading --conflict_graph");
+
+DEFINE_double(conflict_density, // NOLINT(cert-err58-cpp)
+              0.01,
+              "Probability of a conflict between two files in the generated conflict graph");
+
+DEFINE_double(hard_conflict_ratio, // NOLINT(cert-err58-cpp)
+              0.2,
+              "Probability of a generated conflict being a hard constraint");
+
+DEFINE_int32(maximum_soft_conflict_value, // NOLINT(cert-err58-cpp)
+             1,
+             "Largest value of a generated soft constraint");
+
+DEFINE_uint64(conflict_graph_seed, // NOLINT(cert-err58-cpp)
+              0ul,
+              "Seed of the generated conflict graph");
+
+DEFINE_string(conflict_graph_output, // NOLINT(cert-err58-cpp)
+              "",
+              "Write the generated conflict graph in this .scg file and stop, instead of running the algorithm");
+
 DEFINE_string(algorithm, // NOLINT(cert-err58-cpp)
               "greedy",
               "Selected algorithm to solve the problem");
@@ -54,6 +86,11 @@ DEFINE_uint64(number_of_allocation_experiments, // NOLINT(cert-err58-cpp)
               4ul,
               "Number of allocation experiments");
 
+DEFINE_string(local_search_evaluation, // NOLINT(cert-err58-cpp)
+              "suffix",
+              "How the local searches evaluate a move: full, suffix (from the first position it "
+              "changes) or cone (only the activations it can delay)");
+
 DEFINE_string(cplex_output_file, // NOLINT(cert-err58-cpp)
               "./temp/manual/cplex/not_applicable.lp",
               "Example of output model file name of the CPLEX");
@@ -75,6 +112,8 @@ int main(int argc, char **argv) {
     DLOG(INFO) << "Input File of the Tasks and Files: " << FLAGS_tasks_and_files;
     DLOG(INFO) << "Input File of the Cluster: " << FLAGS_cluster;
     DLOG(INFO) << "Input File of the Conflict Graph: " << FLAGS_conflict_graph;
+    DLOG(INFO) << "Instance image: " << FLAGS_instance_image;
+    DLOG(INFO) << "Generate conflict graph: " << FLAGS_generate_conflict_graph;
     DLOG(INFO) << "Selected algorithm: " << FLAGS_algorithm;
     DLOG(INFO) << "Alpha Time weight: " << FLAGS_alpha_time;
     DLOG(INFO) << "Alpha Budget weight: " << FLAGS_alpha_budget;
@@ -87,6 +126,8 @@ int main(int argc, char **argv) {
     std::cout << "Input File of the Tasks and Files: " << FLAGS_tasks_and_files << std::endl;
     std::cout << "Input File of the Cluster: " << FLAGS_cluster << std::endl;
     std::cout << "Input File of the Conflict Graph: " << FLAGS_conflict_graph << std::endl;
+    std::cout << "Instance image: " << FLAGS_instance_image << std::endl;
+    std::cout << "Generate conflict graph: " << FLAGS_generate_conflict_graph << std::endl;
     std::cout << "Selected algorithm: " << FLAGS_algorithm << std::endl;
     std::cout << "Alpha Time weight: " << FLAGS_alpha_time << std::endl;
     std::cout << "Alpha Budget weight: " << FLAGS_alpha_budget << std::endl;
@@ -100,7 +141,32 @@ int main(int argc, char **argv) {
 
     DLOG(INFO) << "... algorithm picked-up ...";
 
-    algorithm->ReadInputFiles(FLAGS_tasks_and_files, FLAGS_cluster, FLAGS_conflict_graph);
+    auto loading_start = std::chrono::steady_clock::now();
+
+    // A generated conflict graph replaces the conflict graph file, and the image replaces the text
+    // files, unless it is the one being compiled or it cannot be used
+    if (FLAGS_generate_conflict_graph) {
+        algorithm->ReadInputFiles(FLAGS_tasks_and_files, FLAGS_cluster);
+        algorithm->GenerateConflictGraph(FLAGS_conflict_density,
+                                         FLAGS_hard_conflict_ratio,
+                                         FLAGS_maximum_soft_conflict_value,
+                                         FLAGS_conflict_graph_seed,
+                                         FLAGS_conflict_graph_output);
+    } else if (FLAGS_algorithm == "compile"
+               || FLAGS_instance_image.empty()
+               || !algorithm->ReadInstanceImage(FLAGS_instance_image)) {
+        algorithm->ReadInputFiles(FLAGS_tasks_and_files, FLAGS_cluster, FLAGS_conflict_graph);
+    }
+    std::cout << "Loading time: "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - loading_start).count()
+              << " s" << std::endl;
+    std::cout << "Peak memory after loading: " << PeakMemoryInMB() << " MB" << std::endl;
+
+    if (FLAGS_generate_conflict_graph && !FLAGS_conflict_graph_output.empty()) {
+        std::cout << "Conflict graph written in " << FLAGS_conflict_graph_output << std::endl;
+        gflags::ShutDownCommandLineFlags();
+        return 0;
+    }
     std::cout << "Number of Activation: " << algorithm->GetActivationSize() << " (including source and target)"
               << std::endl;
     std::cout << "Number of files: " << algorithm->GetFilesSize() << std::endl;
@@ -15,6 +15,7 @@
 
 
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -37,8 +38,8 @@ class Algorithm;
 class Activation {
 public:
     /// Parametrised constructor
-    explicit Activation(const size_t id, std::string tag, std::string name, const double time) :
-            id_(id), tag_(std::move(tag)), name_(std::move(name)), execution_time_(time) {}
+    explicit Activation(const size_t id, std::string_view tag, std::string_view name, const double time) :
+            id_(id), tag_(tag), name_(name), execution_time_(time) {}
 
     ~Activation() = default;
 
@@ -46,22 +47,26 @@ public:
     [[nodiscard]] size_t get_id() const { return id_; }
 
     /// Getter for tag_
-    [[nodiscard]] const std::string &get_tag() const { return tag_; }
+    [[nodiscard]] std::string_view get_tag() const { return tag_; }
 
     /// Getter for name_
-    [[nodiscard]] const std::string &get_name() const { return name_; }
+    [[nodiscard]] std::string_view get_name() const { return name_; }
 
     /// Getter for execution_time_
     [[nodiscard]] double get_time() const { return execution_time_; }
 
     /// Getter for input_files_
-    [[nodiscard]] std::vector<std::shared_ptr<File>> get_input_files() const { return input_files_; }
+    [[nodiscard]] const std::vector<std::shared_ptr<File>> &get_input_files() const {
+        return input_files_;
+    }
 
     /// Getter for output_files_
-    [[nodiscard]] std::vector<std::shared_ptr<File>> get_output_files() const { return output_files_; }
+    [[nodiscard]] const std::vector<std::shared_ptr<File>> &get_output_files() const {
+        return output_files_;
+    }
 
     /// Getter for requirements_
-    [[nodiscard]] std::vector<int> get_requirements() const { return requirements_; }
+    [[nodiscard]] const std::vector<int> &get_requirements() const { return requirements_; }
 
     /// Adds a input file
     void AddInputFile(const std::shared_ptr<File> &file) {
@@ -132,11 +137,11 @@ private:
     /// The id of the task
     size_t id_;
 
-    /// The tag of the task
-    std::string tag_;
+    /// The tag of the task, interned by the \c Algorithm that read it
+    std::string_view tag_;
 
-    /// The name of the task
-    std::string name_;
+    /// The name of the task, interned by the \c Algorithm that read it
+    std::string_view name_;
 
     /// The execution_time_ necessary to execute this task in a default machine
     double execution_time_;
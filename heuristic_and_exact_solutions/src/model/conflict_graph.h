@@ -14,15 +14,32 @@
 #define APPROXIMATE_SOLUTIONS_SRC_MODEL_CONFLICT_GRAPH_H_
 
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 #include <utility>
 
 /**
  * \class ConflictGraph conflict_graph.h "src/model/conflict_graph.h"
  * \brief Represents the Conflict Graph; store the conflict value between files for all pair of files
+ *
+ * The conflicts are added first and then \c Build() arranges them for the queries. The soft
+ * conflicts are kept as CSR adjacency lists and the hard ones in a separate list per file, so the
+ * memory grows with the number of conflicts. When the graph is small or dense enough, a full
+ * matrix is also kept, so \c ReturnConflict() does not search the lists. Every file with a hard
+ * conflict also gets a bitset of the files it conflicts with, to test it against a set of files a
+ * word at a time.
  */
 class ConflictGraph {
 public:
+    /// How \c ReturnConflict() finds the conflict between two files
+    enum class Backend {
+        kAutomatic,  ///< Chosen by \c Build() from the number of files and of conflicts
+        kDense,      ///< The matrix of all pairs of files
+        kSparse      ///< Binary searches in the adjacency lists
+    };
+
     /// Default constructor
     ConflictGraph() = default;
 
@@ -35,38 +52,257 @@ public:
     /// Getter for the accumulated values of soft constraints
     [[nodiscard]] size_t get_maximum_of_soft_constraints() const { return maximum_of_soft_constraints; }
 
-    /// Redefine the size of the conflict graph
+    /// Setter for the accumulated values of soft constraints
+    void set_maximum_of_soft_constraints(size_t value) { maximum_of_soft_constraints = value; }
+
+    /// Getter for the backend picked by \c Build()
+    [[nodiscard]] Backend get_backend() const { return backend_; }
+
+    /// Redefine the size of the conflict graph, without conflicts
     void Redefine(size_t size) {
         files_size_ = size;
-        conflicts_.resize(size * size, 0);
+        added_.clear();
+        Build();
     }
 
     /// Return the conflict value between the file with ID \c line and file with ID \c column
-    int ReturnConflict(size_t line, size_t column) {
-        return conflicts_[(line * files_size_) + column];
+    [[nodiscard]] int ReturnConflict(size_t line, size_t column) const {
+        if (backend_ == Backend::kDense) {
+            return conflicts_[(line * files_size_) + column];
+        }
+
+        const auto *hard_begin = hard_neighbors_.data() + hard_offsets_[line];
+        const auto *hard_end = hard_neighbors_.data() + hard_offsets_[line + 1ul];
+        if (std::binary_search(hard_begin, hard_end, column)) {
+            return -1;
+        }
+
+        const auto *soft_begin = soft_neighbors_.data() + soft_offsets_[line];
+        const auto *soft_end = soft_neighbors_.data() + soft_offsets_[line + 1ul];
+        const auto *it = std::lower_bound(soft_begin, soft_end, column);
+        if (it != soft_end && *it == column) {
+            return soft_values_[static_cast<size_t>(it - soft_neighbors_.data())];
+        }
+        return 0;
     }
 
     /// Add a new conflict value between the file with ID \c line and file with ID \c column
     void AddConflict(const size_t line, const size_t column, const int value) {
-
-        if (value == 0) {  // Hard constraint
-            conflicts_[(line * files_size_) + column] = -1;
-            conflicts_[(column * files_size_) + line] = -1;
-        } else {
-            conflicts_[(line * files_size_) + column] = value;
-            conflicts_[(column * files_size_) + line] = value;
-        }
+        // A hard constraint is stored as -1; the last value added for a pair wins
+        added_.push_back({std::min(line, column), std::max(line, column), value == 0 ? -1 : value});
 
         if (value > 0) {
             maximum_of_soft_constraints += static_cast<size_t>(value);
         }
     }
 
+    /// Arrange the conflicts added so far for the queries; call it after the last \c AddConflict()
+    void Build(Backend backend = Backend::kAutomatic) {
+        // Keep the last value added for every pair, in the order of the pairs
+        std::stable_sort(added_.begin(), added_.end(), [](const Added &a, const Added &b) {
+            return a.line < b.line || (a.line == b.line && a.column < b.column);
+        });
+        std::vector<Added> pairs;
+        pairs.reserve(added_.size());
+        for (size_t i = 0ul; i < added_.size(); ++i) {
+            if (i + 1ul < added_.size()
+                && added_[i + 1ul].line == added_[i].line
+                && added_[i + 1ul].column == added_[i].column) {
+                continue;
+            }
+            pairs.push_back(added_[i]);
+        }
+        added_.clear();
+        added_.shrink_to_fit();
+
+        // Both directions of every pair
+        soft_offsets_.assign(files_size_ + 1ul, 0ul);
+        hard_offsets_.assign(files_size_ + 1ul, 0ul);
+        for (const auto &pair: pairs) {
+            auto &offsets = pair.value == -1 ? hard_offsets_ : soft_offsets_;
+            ++offsets[pair.line + 1ul];
+            if (pair.line != pair.column) {
+                ++offsets[pair.column + 1ul];
+            }
+        }
+        for (size_t i = 0ul; i < files_size_; ++i) {
+            soft_offsets_[i + 1ul] += soft_offsets_[i];
+            hard_offsets_[i + 1ul] += hard_offsets_[i];
+        }
+        soft_neighbors_.resize(soft_offsets_[files_size_]);
+        soft_values_.resize(soft_offsets_[files_size_]);
+        hard_neighbors_.resize(hard_offsets_[files_size_]);
+
+        // Every row gets the lower IDs first, so the rows come out sorted
+        std::vector<size_t> next_soft(soft_offsets_.begin(), soft_offsets_.end() - 1);
+        std::vector<size_t> next_hard(hard_offsets_.begin(), hard_offsets_.end() - 1);
+        auto add = [&](size_t line, size_t column, int value) {
+            if (value == -1) {
+                hard_neighbors_[next_hard[line]++] = column;
+            } else {
+                soft_values_[next_soft[line]] = value;
+                soft_neighbors_[next_soft[line]++] = column;
+            }
+        };
+        for (const auto &pair: pairs) {
+            add(pair.line, pair.column, pair.value);
+            if (pair.line != pair.column) {
+                add(pair.column, pair.line, pair.value);
+            }
+        }
+
+        BuildHardConflictBits();
+
+        if (backend == Backend::kAutomatic) {
+            backend = PickBackend(pairs.size());
+        }
+        backend_ = backend;
+        conflicts_.clear();
+        conflicts_.shrink_to_fit();
+        if (backend_ == Backend::kDense) {
+            conflicts_.resize(files_size_ * files_size_, 0);
+            for (const auto &pair: pairs) {
+                conflicts_[(pair.line * files_size_) + pair.column] = pair.value;
+                conflicts_[(pair.column * files_size_) + pair.line] = pair.value;
+            }
+        }
+    }
+
+    /// Call \c function(neighbor, value) for every file in conflict with the file \c file
+    template<typename Function>
+    void ForEachConflict(size_t file, Function function) const {
+        for (auto i = hard_offsets_[file]; i < hard_offsets_[file + 1ul]; ++i) {
+            function(hard_neighbors_[i], -1);
+        }
+        ForEachSoftConflict(file, function);
+    }
+
+    /// Call \c function(neighbor, value) for every file in soft conflict with the file \c file
+    template<typename Function>
+    void ForEachSoftConflict(size_t file, Function function) const {
+        for (auto i = soft_offsets_[file]; i < soft_offsets_[file + 1ul]; ++i) {
+            function(soft_neighbors_[i], soft_values_[i]);
+        }
+    }
+
+    /// Call \c function(neighbor) for every file in hard conflict with the file \c file
+    template<typename Function>
+    void ForEachHardConflict(size_t file, Function function) const {
+        for (auto i = hard_offsets_[file]; i < hard_offsets_[file + 1ul]; ++i) {
+            function(hard_neighbors_[i]);
+        }
+    }
+
+    /// Number of 64-bit words of a bitset over all files
+    [[nodiscard]] size_t get_file_words() const { return file_words_; }
+
+    /// Whether \c Build() kept the bitsets of the hard conflicts; too many of them are not kept
+    [[nodiscard]] bool has_hard_conflict_bits() const { return has_hard_conflict_bits_; }
+
+    /// The bitset of the files in hard conflict with \c file; \c nullptr when it has none
+    [[nodiscard]] const uint64_t *GetHardConflictBits(size_t file) const {
+        auto row = hard_conflict_rows_[file];
+        return row == kNoRow ? nullptr : hard_conflict_bits_.data() + (row * file_words_);
+    }
+
 private:
+    /// A conflict waiting for \c Build(), with \c line not greater than \c column
+    struct Added {
+        size_t line;
+        size_t column;
+        int value;
+    };
+
+    /// Matrices up to this size are always kept, 16 MB of conflicts
+    static constexpr size_t kSmallMatrix = 1ul << 22;
+
+    /// The matrix is also kept when at least 1 / kDenseRatio of its cells hold a conflict, about
+    /// the point where the adjacency lists take as much memory as the matrix
+    static constexpr size_t kDenseRatio = 4ul;
+
+    /// Bitsets of the hard conflicts are kept up to this many words, 32 MB
+    static constexpr size_t kLargestHardConflictBits = 1ul << 22;
+
+    /// The row of the files without hard conflicts
+    static constexpr size_t kNoRow = std::numeric_limits<size_t>::max();
+
+    /// Fill the bitsets of the files with hard conflicts from \c hard_neighbors_
+    void BuildHardConflictBits() {
+        file_words_ = (files_size_ + 63ul) / 64ul;
+        hard_conflict_rows_.assign(files_size_, kNoRow);
+        hard_conflict_bits_.clear();
+
+        auto row_size = 0ul;
+        for (size_t i = 0ul; i < files_size_; ++i) {
+            if (hard_offsets_[i] != hard_offsets_[i + 1ul]) {
+                hard_conflict_rows_[i] = row_size++;
+            }
+        }
+        has_hard_conflict_bits_ = row_size * file_words_ <= kLargestHardConflictBits;
+        if (!has_hard_conflict_bits_) {
+            hard_conflict_rows_.assign(files_size_, kNoRow);
+            hard_conflict_bits_.shrink_to_fit();
+            return;
+        }
+
+        hard_conflict_bits_.assign(row_size * file_words_, 0ul);
+        for (size_t i = 0ul; i < files_size_; ++i) {
+            auto row = hard_conflict_rows_[i];
+            for (auto j = hard_offsets_[i]; j < hard_offsets_[i + 1ul]; ++j) {
+                auto neighbor = hard_neighbors_[j];
+                hard_conflict_bits_[(row * file_words_) + (neighbor / 64ul)] |=
+                        uint64_t{1} << (neighbor % 64ul);
+            }
+        }
+    }
+
+    /// The backend for \c pair_size distinct pairs of files in conflict
+    [[nodiscard]] Backend PickBackend(size_t pair_size) const {
+        auto cells = files_size_ * files_size_;
+
+        if (cells <= kSmallMatrix || 2ul * pair_size * kDenseRatio >= cells) {
+            return Backend::kDense;
+        }
+        return Backend::kSparse;
+    }
+
     ///
-    size_t files_size_;
+    size_t files_size_ = 0ul;
+
+    /// The conflicts added since the last \c Build()
+    std::vector<Added> added_;
+
+    /// Soft conflicts of file i are [soft_offsets_[i], soft_offsets_[i + 1]) of \c soft_neighbors_
+    std::vector<size_t> soft_offsets_;
+
+    /// The files in soft conflict, sorted in every row
+    std::vector<size_t> soft_neighbors_;
+
+    /// The value of every soft conflict in \c soft_neighbors_
+    std::vector<int> soft_values_;
+
+    /// Hard conflicts of file i are [hard_offsets_[i], hard_offsets_[i + 1]) of \c hard_neighbors_
+    std::vector<size_t> hard_offsets_;
+
+    /// The files in hard conflict, sorted in every row
+    std::vector<size_t> hard_neighbors_;
+
+    /// Number of 64-bit words of a bitset over all files
+    size_t file_words_ = 0ul;
+
+    /// Whether the bitsets of the hard conflicts were kept
+    bool has_hard_conflict_bits_ = false;
+
+    /// The row of \c hard_conflict_bits_ of every file, \c kNoRow when it has no hard conflicts
+    std::vector<size_t> hard_conflict_rows_;
+
+    /// The bitsets of the files with hard conflicts, \c file_words_ words each
+    std::vector<uint64_t> hard_conflict_bits_;
+
+    /// The backend used by \c ReturnConflict()
+    Backend backend_ = Backend::kSparse;
 
-    /// The matrix containing all conflict values
+    /// The matrix containing all conflict values, only kept by the dense backend
     std::vector<int> conflicts_;
 
     /// A positive integer that contain the sum of all soft conflict value
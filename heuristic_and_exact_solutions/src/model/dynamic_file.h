@@ -32,7 +32,7 @@ class Activation;
 class DynamicFile : public File {
 public:
     /// Parametrized constructor
-    explicit DynamicFile(const size_t id, const std::string &name, const double size) :
+    explicit DynamicFile(const size_t id, std::string_view name, const double size) :
             File(id, name, size) {}
 
     /// Default destructor
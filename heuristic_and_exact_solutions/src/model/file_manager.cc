@@ -12,48 +12,49 @@
 
 #include "file_manager.h"
 
-FileManager::FileManager(size_t files_size, size_t storages_size, const std::shared_ptr<ConflictGraph> &conflict_graph)
-        : total_conflict_(0ul),
-          file_allocations_(files_size, std::numeric_limits<size_t>::max()),
+FileManager::FileManager(std::vector<double> file_sizes_in_GB,
+                         size_t storages_size,
+                         const std::shared_ptr<ConflictGraph> &conflict_graph)
+        : storages_size_(storages_size),
+          total_conflict_(0ul),
+          file_sizes_in_GB_(std::move(file_sizes_in_GB)),
+          file_allocations_(file_sizes_in_GB_.size(), kNoValue<IndexType>),
           storages_conflict_(storages_size, 0ul),
-          files_distribution_(storages_size, std::list<size_t>()),
+          storage_sizes_in_GB_(storages_size, 0.0),
+          storage_first_files_(storages_size, kNoValue<IndexType>),
+          next_files_(file_sizes_in_GB_.size(), kNoValue<IndexType>),
+          previous_files_(file_sizes_in_GB_.size(), kNoValue<IndexType>),
+          conflict_with_storage_(file_sizes_in_GB_.size() * storages_size, 0ul),
+          storage_files_(storages_size * conflict_graph->get_file_words(), 0ul),
           conflict_graph_(conflict_graph) {
 }
 
 size_t FileManager::get_file_allocation(size_t file_id) const {
-    return file_allocations_[file_id];
+    return WidenIndex(file_allocations_[file_id]);
 }
 
 void FileManager::set_file_allocation(size_t file_id, size_t storage_id) {
 
     DLOG(INFO) << "file_id " << file_id << " storage_id " << storage_id;
 
-    if (file_allocations_[file_id] != std::numeric_limits<size_t>::max()) {
+    if (file_allocations_[file_id] != kNoValue<IndexType>) {
         LOG(FATAL) << "Reassign is not permitted";
     }
-
-    file_allocations_[file_id] = storage_id;
-//    auto sum_of_conflicts = 0ul;
-    auto sum_of_conflicts = storages_conflict_[storage_id];
-    auto previous_sum = storages_conflict_[storage_id];
-#ifndef NDEBUG
-    auto it = std::find(files_distribution_[storage_id].begin(), files_distribution_[storage_id].end(), file_id);
-    if (it != files_distribution_[storage_id].end()) {
-        LOG(FATAL) << "Trying to assign the file more than one time";
-    }
-#endif
-    int file_conflict;
-    for (auto stored_file_id: files_distribution_[storage_id]) {
-        file_conflict = conflict_graph_->ReturnConflict(file_id, stored_file_id);
-        DLOG(INFO) << "file_conflict " << file_conflict;
-        if (file_conflict < 0) {
+    conflict_graph_->ForEachHardConflict(file_id, [&](size_t other_file_id) {
+        if (other_file_id != file_id && file_allocations_[other_file_id] == storage_id) {
             LOG(FATAL) << "Not acceptable file assign with hard-constrain conflict";
         }
-        sum_of_conflicts += static_cast<size_t>(file_conflict);
-    }
-    storages_conflict_[storage_id] = sum_of_conflicts;
-    total_conflict_ += (sum_of_conflicts - previous_sum);
-    files_distribution_[storage_id].push_back(file_id);
+    });
+
+    // The soft conflicts with the files already in the storage
+    auto sum_of_conflicts = GetConflictWithStorage(file_id, storage_id);
+    storages_conflict_[storage_id] += sum_of_conflicts;
+    total_conflict_ += sum_of_conflicts;
+
+    file_allocations_[file_id] = static_cast<IndexType>(storage_id);
+    LinkFile(file_id, storage_id);
+    SetStorageFile(storage_id, file_id, true);
+    UpdateConflictWithStorage(file_id, storage_id, true);
 }
 
 bool FileManager::ChangeFileAllocation(size_t file_id, size_t new_storage_id) {
@@ -62,56 +63,142 @@ bool FileManager::ChangeFileAllocation(size_t file_id, size_t new_storage_id) {
     if (old_storage_id == new_storage_id) {
         LOG(FATAL) << "Same storage is not permitted";
     }
-    auto it = std::find(files_distribution_[old_storage_id].begin(), files_distribution_[old_storage_id].end(),
-            file_id);
-    if (it != files_distribution_[old_storage_id].end()) {
-        // Accumulate old vm conflict between files
-        int file_conflict;
-        auto sum_of_conflicts_old_vm = 0ul;
-        for (auto stored_file_id: files_distribution_[old_storage_id]) {
-            if (file_id != stored_file_id) {
-                file_conflict = conflict_graph_->ReturnConflict(file_id, stored_file_id);
-                if (file_conflict < 0) {
-                    LOG(FATAL) << "Makes no sense, would not be a hard-conflict here";
-                }
-                sum_of_conflicts_old_vm += static_cast<size_t>(file_conflict);
-            }
-        }
-        // Accumulate old vm conflict between files
-        auto sum_of_conflicts_new_vm = 0ul;
-        for (auto stored_file_id: files_distribution_[new_storage_id]) {
-            file_conflict = conflict_graph_->ReturnConflict(file_id, stored_file_id);
-            if (file_conflict < 0) {
-                return false;
-            }
-            sum_of_conflicts_new_vm += static_cast<size_t>(file_conflict);
-        }
-        storages_conflict_[old_storage_id] -= sum_of_conflicts_old_vm;
-        storages_conflict_[new_storage_id] += sum_of_conflicts_new_vm;
-        total_conflict_ += (sum_of_conflicts_new_vm - sum_of_conflicts_old_vm);
-        // Moving file from between storages
-        files_distribution_[old_storage_id].erase(it);
-        files_distribution_[new_storage_id].push_back(file_id);
-        file_allocations_[file_id] = new_storage_id;
-    } else {
+    if (old_storage_id == kNoValue<IndexType>) {
         LOG(FATAL) << "File ID not found";
     }
+    if (FileHasHardConstraintsAgainstVmFiles(file_id, new_storage_id)) {
+        return false;
+    }
+
+    // Accumulate the conflicts of the file in the old and in the new storage
+    auto sum_of_conflicts_old_vm = GetConflictWithStorage(file_id, old_storage_id);
+    auto sum_of_conflicts_new_vm = GetConflictWithStorage(file_id, new_storage_id);
+    storages_conflict_[old_storage_id] -= sum_of_conflicts_old_vm;
+    storages_conflict_[new_storage_id] += sum_of_conflicts_new_vm;
+    total_conflict_ += (sum_of_conflicts_new_vm - sum_of_conflicts_old_vm);
+
+    // Moving file from between storages
+    UnlinkFile(file_id, old_storage_id);
+    LinkFile(file_id, new_storage_id);
+    SetStorageFile(old_storage_id, file_id, false);
+    SetStorageFile(new_storage_id, file_id, true);
+    UpdateConflictWithStorage(file_id, old_storage_id, false);
+    UpdateConflictWithStorage(file_id, new_storage_id, true);
+    file_allocations_[file_id] = static_cast<IndexType>(new_storage_id);
     return true;
 }
 
+void FileManager::RemoveFileAllocation(size_t file_id) {
+
+    auto storage_id = file_allocations_[file_id];
+    if (storage_id == kNoValue<IndexType>) {
+        LOG(FATAL) << "File ID not found";
+    }
+
+    auto sum_of_conflicts = GetConflictWithStorage(file_id, storage_id);
+    storages_conflict_[storage_id] -= sum_of_conflicts;
+    total_conflict_ -= sum_of_conflicts;
+
+    UnlinkFile(file_id, storage_id);
+    SetStorageFile(storage_id, file_id, false);
+    UpdateConflictWithStorage(file_id, storage_id, false);
+    file_allocations_[file_id] = kNoValue<IndexType>;
+}
+
+void FileManager::Reset() {
+    total_conflict_ = 0ul;
+    std::fill(file_allocations_.begin(), file_allocations_.end(), kNoValue<IndexType>);
+    std::fill(storages_conflict_.begin(), storages_conflict_.end(), 0ul);
+    std::fill(storage_sizes_in_GB_.begin(), storage_sizes_in_GB_.end(), 0.0);
+    std::fill(storage_first_files_.begin(), storage_first_files_.end(), kNoValue<IndexType>);
+    std::fill(next_files_.begin(), next_files_.end(), kNoValue<IndexType>);
+    std::fill(previous_files_.begin(), previous_files_.end(), kNoValue<IndexType>);
+    std::fill(conflict_with_storage_.begin(), conflict_with_storage_.end(), 0ul);
+    std::fill(storage_files_.begin(), storage_files_.end(), 0ul);
+}
+
 bool FileManager::FileHasHardConstraintsAgainstVmFiles(size_t file_id, size_t vm_id) {
-    int file_conflict;
-    for (auto stored_file_id: files_distribution_[vm_id]) {
-        if (file_id != stored_file_id) {
-            file_conflict = conflict_graph_->ReturnConflict(file_id, stored_file_id);
-            if (file_conflict < 0) {
-                return true;
-            }
+    if (file_allocations_[file_id] == vm_id) {
+        LOG(FATAL) << "Makes no sense, the file is already assign to a VM";
+    }
+    if (conflict_graph_->has_hard_conflict_bits()) {
+        const auto *hard_conflicts = conflict_graph_->GetHardConflictBits(file_id);
+        if (hard_conflicts == nullptr) {
+            return false;
+        }
+        // The file itself is not in the storage, so it only meets the other files
+        auto words = conflict_graph_->get_file_words();
+        const auto *files = storage_files_.data() + (vm_id * words);
+        uint64_t common = 0ul;
+        for (size_t i = 0ul; i < words; ++i) {
+            common |= hard_conflicts[i] & files[i];
+        }
+        return common != 0ul;
+    }
+
+    bool has_hard_conflict = false;
+    conflict_graph_->ForEachHardConflict(file_id, [&](size_t other_file_id) {
+        if (other_file_id != file_id && file_allocations_[other_file_id] == vm_id) {
+            has_hard_conflict = true;
+        }
+    });
+    return has_hard_conflict;
+}
+
+void FileManager::UpdateConflictWithStorage(size_t file_id, size_t storage_id, bool stored) {
+    conflict_graph_->ForEachSoftConflict(file_id, [&](size_t other_file_id, int file_conflict) {
+        if (other_file_id == file_id) {
+            return;
+        }
+        auto &sum = conflict_with_storage_[(other_file_id * storages_size_) + storage_id];
+        if (stored) {
+            sum += static_cast<size_t>(file_conflict);
         } else {
-            LOG(FATAL) << "Makes no sense, the file is already assign to a VM";
+            sum -= static_cast<size_t>(file_conflict);
         }
+    });
+}
+
+void FileManager::SetStorageFile(size_t storage_id, size_t file_id, bool stored) {
+    auto &word = storage_files_[(storage_id * conflict_graph_->get_file_words()) + (file_id / 64ul)];
+    auto bit = uint64_t{1} << (file_id % 64ul);
+
+    word = stored ? (word | bit) : (word & ~bit);
+
+    // An empty storage gets back an exact zero, whatever the rounding of the sizes
+    auto &size_in_GB = storage_sizes_in_GB_[storage_id];
+    if (stored) {
+        size_in_GB += file_sizes_in_GB_[file_id];
+    } else if (storage_first_files_[storage_id] == kNoValue<IndexType>) {
+        size_in_GB = 0.0;
+    } else {
+        size_in_GB -= file_sizes_in_GB_[file_id];
+    }
+}
+
+void FileManager::LinkFile(size_t file_id, size_t storage_id) {
+    auto first_file_id = storage_first_files_[storage_id];
+    previous_files_[file_id] = kNoValue<IndexType>;
+    next_files_[file_id] = first_file_id;
+    if (first_file_id != kNoValue<IndexType>) {
+        previous_files_[first_file_id] = static_cast<IndexType>(file_id);
+    }
+    storage_first_files_[storage_id] = static_cast<IndexType>(file_id);
+}
+
+void FileManager::UnlinkFile(size_t file_id, size_t storage_id) {
+    auto previous_file_id = previous_files_[file_id];
+    auto next_file_id = next_files_[file_id];
+    if (previous_file_id == kNoValue<IndexType>) {
+        storage_first_files_[storage_id] = next_file_id;
+    } else {
+        next_files_[previous_file_id] = next_file_id;
+    }
+    if (next_file_id != kNoValue<IndexType>) {
+        previous_files_[next_file_id] = previous_file_id;
     }
-    return false;
+    next_files_[file_id] = kNoValue<IndexType>;
+    previous_files_[file_id] = kNoValue<IndexType>;
 }
 
 size_t FileManager::get_file_privacy_exposure() const {
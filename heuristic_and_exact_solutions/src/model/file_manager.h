@@ -15,19 +15,33 @@
 
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <glog/logging.h>
 #include <limits>
-#include <list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include "src/common/index_types.h"
 #include "src/model/conflict_graph.h"
 
+/**
+ * \class FileManager file_manager.h "src/model/file_manager.h"
+ * \brief Keeps the storage of every file and the conflicts between the files of each storage
+ *
+ * The files of a storage are kept in a list linked through the files themselves, so placing,
+ * moving and removing a file never allocates and the lists take the same memory however the files
+ * are spread over the storages. For every file and storage, the sum of the soft conflicts
+ * between the file and the files of the storage is kept up to date while the files come and go,
+ * so placing or moving a file costs the number of its conflicts, not the number of files of the
+ * storages. The size of the files of every storage is kept up to date the same way.
+ */
 class FileManager {
 public:
-    /// Constructor declaration
-    explicit FileManager(size_t, size_t, const std::shared_ptr<ConflictGraph> &);
+    /// Constructor declaration, from the sizes of the files in GB, the number of storages and the
+    /// conflicts between the files
+    FileManager(std::vector<double>, size_t, const std::shared_ptr<ConflictGraph> &);
 
     /// Pass the file id, and return the storage id where the file is located
     [[nodiscard]] size_t get_file_allocation(size_t) const;
@@ -38,23 +52,86 @@ public:
     ///
     bool ChangeFileAllocation(size_t file_id, size_t new_storage_id);
 
+    /// Take the file \c file_id out of its storage, undoing \c set_file_allocation()
+    void RemoveFileAllocation(size_t file_id);
+
+    /// Take every file out of its storage, keeping the memory of the storages
+    void Reset();
+
     ///
     bool FileHasHardConstraintsAgainstVmFiles(size_t, size_t);
 
     ///
     [[nodiscard]] size_t get_file_privacy_exposure() const;
+
+    /// Size in GB of the files stored in the storage \c storage_id
+    [[nodiscard]] double GetStorageSizeInGB(size_t storage_id) const {
+        return storage_sizes_in_GB_[storage_id];
+    }
+
+    /// Call \c function with the ID of every file stored in the storage \c storage_id
+    template<typename Function>
+    void ForEachStorageFile(size_t storage_id, Function &&function) const {
+        for (auto file_id = storage_first_files_[storage_id]; file_id != kNoValue<IndexType>;
+             file_id = next_files_[file_id]) {
+            function(WidenIndex(file_id));
+        }
+    }
+
+    /// Sum of the soft conflicts between the file \c file_id and the other files in the storage
+    /// \c storage_id
+    [[nodiscard]] size_t GetConflictWithStorage(size_t file_id, size_t storage_id) const {
+        return conflict_with_storage_[(file_id * storages_size_) + storage_id];
+    }
 private:
+    /// Add the soft conflicts of the file \c file_id to the sums of its neighbors with the storage
+    /// \c storage_id, or subtract them
+    void UpdateConflictWithStorage(size_t file_id, size_t storage_id, bool stored);
+
+    /// Add the file \c file_id to the bitset and to the size of the storage \c storage_id, or
+    /// remove it
+    void SetStorageFile(size_t storage_id, size_t file_id, bool stored);
+
+    /// Put the file \c file_id at the front of the list of the storage \c storage_id
+    void LinkFile(size_t file_id, size_t storage_id);
+
+    /// Take the file \c file_id out of the list of the storage \c storage_id
+    void UnlinkFile(size_t file_id, size_t storage_id);
+
+    ///
+    size_t storages_size_;
+
     ///
     size_t total_conflict_;
 
+    /// Size in GB of every file
+    std::vector<double> file_sizes_in_GB_;
+
     /// Allocation of files in theirs storages
-    std::vector<size_t> file_allocations_;
+    std::vector<IndexType> file_allocations_;
 
     ///
     std::vector<size_t> storages_conflict_;
 
-    /// Each position in the vector represents a list of files stored in that storage
-    std::vector<std::list<size_t>> files_distribution_;
+    /// Size in GB of the files of every storage
+    std::vector<double> storage_sizes_in_GB_;
+
+    /// First file of the list of every storage, \c kNoValue for an empty storage
+    std::vector<IndexType> storage_first_files_;
+
+    /// Next file of every file in the list of its storage, \c kNoValue for the last one
+    std::vector<IndexType> next_files_;
+
+    /// Previous file of every file in the list of its storage, \c kNoValue for the first one
+    std::vector<IndexType> previous_files_;
+
+    /// Sum of the soft conflicts between every file and the files of every storage, a line of
+    /// \c storages_size_ sums per file
+    std::vector<size_t> conflict_with_storage_;
+
+    /// The files stored in every storage as a bitset, \c ConflictGraph::get_file_words() words
+    /// per storage
+    std::vector<uint64_t> storage_files_;
 
     ///
     std::shared_ptr<ConflictGraph> conflict_graph_;
@@ -0,0 +1,117 @@
+/**
+ * \file src/model/instance_store.cc
+ * \brief Contains the \c InstanceStore class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the construction of the flat copy of the instance
+ */
+
+#include "src/model/instance_store.h"
+
+#include "src/model/activation.h"
+#include "src/model/static_file.h"
+
+/**
+ * The predecessors are the transposed successors, so the predecessors of every activation come
+ * sorted by ID. The users of every file are the transposed input and output files, also sorted by
+ * ID, each with the slot of its read or write.
+ *
+ * \param[in] activations       The activations, indexed by ID
+ * \param[in] files             The files, indexed by ID
+ * \param[in] successors        The successors of every activation
+ * \param[in] requirement_size  Number of requirements of every activation
+ */
+void InstanceStore::Build(const std::vector<std::shared_ptr<Activation>> &activations,
+                          const std::vector<std::shared_ptr<File>> &files,
+                          const std::vector<std::vector<size_t>> &successors,
+                          size_t requirement_size) {
+    auto activation_size = activations.size();
+
+    requirement_size_ = requirement_size;
+    activation_times_.resize(activation_size);
+    requirement_values_.resize(activation_size * requirement_size);
+    successor_offsets_.assign(activation_size + 1ul, 0ul);
+    predecessor_offsets_.assign(activation_size + 1ul, 0ul);
+    input_file_offsets_.assign(activation_size + 1ul, 0ul);
+    output_file_offsets_.assign(activation_size + 1ul, 0ul);
+    successors_.clear();
+    input_files_.clear();
+    output_files_.clear();
+
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        const auto &activation = activations[i];
+
+        activation_times_[i] = activation->get_time();
+        for (size_t r = 0ul; r < requirement_size; ++r) {
+            requirement_values_[(i * requirement_size) + r] = activation->GetRequirementValue(r);
+        }
+        successors_.insert(successors_.end(), successors[i].begin(), successors[i].end());
+        successor_offsets_[i + 1ul] = successors_.size();
+        for (const auto &file: activation->get_input_files()) {
+            input_files_.push_back(file->get_id());
+        }
+        input_file_offsets_[i + 1ul] = input_files_.size();
+        for (const auto &file: activation->get_output_files()) {
+            output_files_.push_back(file->get_id());
+        }
+        output_file_offsets_[i + 1ul] = output_files_.size();
+    }
+
+    // Transpose the successors
+    for (auto successor: successors_) {
+        ++predecessor_offsets_[successor + 1ul];
+    }
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        predecessor_offsets_[i + 1ul] += predecessor_offsets_[i];
+    }
+    predecessors_.resize(successors_.size());
+    std::vector<size_t> next_predecessor(predecessor_offsets_.begin(),
+                                         predecessor_offsets_.end() - 1);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        for (auto j = successor_offsets_[i]; j < successor_offsets_[i + 1ul]; ++j) {
+            predecessors_[next_predecessor[successors_[j]]++] = i;
+        }
+    }
+
+    // Transpose the input and output files
+    file_user_offsets_.assign(files.size() + 1ul, 0ul);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        for (auto file_id: GetInputFiles(i)) {
+            ++file_user_offsets_[file_id + 1ul];
+        }
+        for (auto file_id: GetOutputFiles(i)) {
+            ++file_user_offsets_[file_id + 1ul];
+        }
+    }
+    for (size_t i = 0ul; i < files.size(); ++i) {
+        file_user_offsets_[i + 1ul] += file_user_offsets_[i];
+    }
+    file_users_.resize(file_user_offsets_.back());
+    file_user_slots_.resize(file_user_offsets_.back());
+    std::vector<size_t> next_user(file_user_offsets_.begin(), file_user_offsets_.end() - 1);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        for (auto j = input_file_offsets_[i]; j < input_file_offsets_[i + 1ul]; ++j) {
+            file_user_slots_[next_user[input_files_[j]]] = j;
+            file_users_[next_user[input_files_[j]]++] = i;
+        }
+        for (auto j = output_file_offsets_[i]; j < output_file_offsets_[i + 1ul]; ++j) {
+            file_user_slots_[next_user[output_files_[j]]] = input_files_.size() + j;
+            file_users_[next_user[output_files_[j]]++] = i;
+        }
+    }
+
+    file_sizes_in_GB_.resize(files.size());
+    file_static_storages_.resize(files.size());
+    for (size_t i = 0ul; i < files.size(); ++i) {
+        file_sizes_in_GB_[i] = files[i]->get_size_in_GB();
+        if (auto static_file = std::dynamic_pointer_cast<StaticFile>(files[i])) {
+            file_static_storages_[i] = static_file->GetFirstVm();
+        } else {
+            file_static_storages_[i] = kDynamic;
+        }
+    }
+}
@@ -0,0 +1,210 @@
+/**
+ * \file src/model/instance_store.h
+ * \brief Contains the \c InstanceStore class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c InstanceStore class, the flat read-only copy of the instance
+ * used by the search
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_MODEL_INSTANCE_STORE_H_
+#define APPROXIMATE_SOLUTIONS_SRC_MODEL_INSTANCE_STORE_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class Activation;
+class File;
+
+/**
+ * \class IdRange instance_store.h "src/model/instance_store.h"
+ * \brief A view of consecutive IDs of one of the \c InstanceStore adjacency arrays
+ */
+class IdRange {
+public:
+    /// Views [\c begin, \c end)
+    IdRange(const size_t *begin, const size_t *end) : begin_(begin), end_(end) {}
+
+    /// First ID
+    [[nodiscard]] const size_t *begin() const { return begin_; }
+
+    /// One past the last ID
+    [[nodiscard]] const size_t *end() const { return end_; }
+
+    /// Number of IDs
+    [[nodiscard]] size_t size() const { return static_cast<size_t>(end_ - begin_); }
+
+    /// Whether there are no IDs
+    [[nodiscard]] bool empty() const { return begin_ == end_; }
+
+    /// The ID at \c position
+    size_t operator[](size_t position) const { return begin_[position]; }
+
+private:
+    /// First ID
+    const size_t *begin_;
+
+    /// One past the last ID
+    const size_t *end_;
+};
+
+/**
+ * \class InstanceStore instance_store.h "src/model/instance_store.h"
+ * \brief The activations, files and workflow of an instance as contiguous arrays
+ *
+ * It is built once the instance is loaded and never changes afterward. The values of the
+ * activations and files are kept one array per field, and the successors, predecessors, input files
+ * and output files of every activation as CSR arrays: the ones of activation i are
+ * [offsets[i], offsets[i + 1]) of the array of IDs. The search reads it without touching the
+ * \c Activation and \c File objects.
+ */
+class InstanceStore {
+public:
+    /// Fills the arrays from the loaded objects and the successors of every activation
+    void Build(const std::vector<std::shared_ptr<Activation>> &activations,
+               const std::vector<std::shared_ptr<File>> &files,
+               const std::vector<std::vector<size_t>> &successors,
+               size_t requirement_size);
+
+    /// Number of activations, with the source and target ones
+    [[nodiscard]] size_t GetActivationSize() const { return activation_times_.size(); }
+
+    /// Number of files
+    [[nodiscard]] size_t GetFileSize() const { return file_sizes_in_GB_.size(); }
+
+    /// Time of the activation \c id in a machine without slowdown
+    [[nodiscard]] double GetActivationTime(size_t id) const { return activation_times_[id]; }
+
+    /// Value of the requirement \c requirement_id of the activation \c id
+    [[nodiscard]] int GetRequirementValue(size_t id, size_t requirement_id) const {
+        return requirement_values_[(id * requirement_size_) + requirement_id];
+    }
+
+    /// The activations depending on the activation \c id
+    [[nodiscard]] IdRange GetSuccessors(size_t id) const {
+        return Range(successor_offsets_, successors_, id);
+    }
+
+    /// The activations the activation \c id depends on
+    [[nodiscard]] IdRange GetPredecessors(size_t id) const {
+        return Range(predecessor_offsets_, predecessors_, id);
+    }
+
+    /// The files read by the activation \c id
+    [[nodiscard]] IdRange GetInputFiles(size_t id) const {
+        return Range(input_file_offsets_, input_files_, id);
+    }
+
+    /// The files written by the activation \c id
+    [[nodiscard]] IdRange GetOutputFiles(size_t id) const {
+        return Range(output_file_offsets_, output_files_, id);
+    }
+
+    /// The activations reading or writing the file \c id
+    [[nodiscard]] IdRange GetFileUsers(size_t id) const {
+        return Range(file_user_offsets_, file_users_, id);
+    }
+
+    /// The slots of the reads and writes of the file \c id, in the order of \c GetFileUsers()
+    [[nodiscard]] IdRange GetFileUserSlots(size_t id) const {
+        return Range(file_user_offsets_, file_user_slots_, id);
+    }
+
+    /// Slot of the first input file of the activation \c id; every read and write of every
+    /// activation has a slot, the inputs of all activations and then their outputs
+    [[nodiscard]] size_t GetInputSlot(size_t id) const { return input_file_offsets_[id]; }
+
+    /// Slot of the first output file of the activation \c id
+    [[nodiscard]] size_t GetOutputSlot(size_t id) const {
+        return input_files_.size() + output_file_offsets_[id];
+    }
+
+    /// Number of slots
+    [[nodiscard]] size_t GetSlotSize() const { return input_files_.size() + output_files_.size(); }
+
+    /// Size in GB of the file \c id
+    [[nodiscard]] double GetFileSizeInGB(size_t id) const { return file_sizes_in_GB_[id]; }
+
+    /// Size in GB of every file
+    [[nodiscard]] const std::vector<double> &GetFileSizesInGB() const { return file_sizes_in_GB_; }
+
+    /// Whether the file \c id is a static file, placed by the instance
+    [[nodiscard]] bool IsStaticFile(size_t id) const {
+        return file_static_storages_[id] != kDynamic;
+    }
+
+    /// The storage holding the static file \c id; the maximum \c size_t for dynamic files
+    [[nodiscard]] size_t GetStaticFileStorage(size_t id) const { return file_static_storages_[id]; }
+
+private:
+    /// The storage of the dynamic files, which are placed by the search
+    static constexpr size_t kDynamic = std::numeric_limits<size_t>::max();
+
+    /// The row \c id of a CSR array
+    static IdRange Range(const std::vector<size_t> &offsets,
+                         const std::vector<size_t> &ids,
+                         size_t id) {
+        return {ids.data() + offsets[id], ids.data() + offsets[id + 1ul]};
+    }
+
+    /// Number of requirements of every activation
+    size_t requirement_size_ = 0ul;
+
+    /// Time of every activation
+    std::vector<double> activation_times_;
+
+    /// The requirement values of every activation, \c requirement_size_ per activation
+    std::vector<int> requirement_values_;
+
+    /// Successors of activation i are [successor_offsets_[i], successor_offsets_[i + 1]) of
+    /// \c successors_
+    std::vector<size_t> successor_offsets_;
+
+    /// The successors of all activations
+    std::vector<size_t> successors_;
+
+    /// Predecessors of activation i are [predecessor_offsets_[i], predecessor_offsets_[i + 1]) of
+    /// \c predecessors_
+    std::vector<size_t> predecessor_offsets_;
+
+    /// The predecessors of all activations
+    std::vector<size_t> predecessors_;
+
+    /// Input files of activation i are [input_file_offsets_[i], input_file_offsets_[i + 1]) of
+    /// \c input_files_
+    std::vector<size_t> input_file_offsets_;
+
+    /// The input files of all activations
+    std::vector<size_t> input_files_;
+
+    /// Output files of activation i are [output_file_offsets_[i], output_file_offsets_[i + 1]) of
+    /// \c output_files_
+    std::vector<size_t> output_file_offsets_;
+
+    /// The output files of all activations
+    std::vector<size_t> output_files_;
+
+    /// Users of file i are [file_user_offsets_[i], file_user_offsets_[i + 1]) of \c file_users_
+    std::vector<size_t> file_user_offsets_;
+
+    /// The activations reading or writing every file
+    std::vector<size_t> file_users_;
+
+    /// The slots of the reads and writes of every file, along \c file_users_
+    std::vector<size_t> file_user_slots_;
+
+    /// Size in GB of every file
+    std::vector<double> file_sizes_in_GB_;
+
+    /// The storage of every static file, \c kDynamic for the dynamic files
+    std::vector<size_t> file_static_storages_;
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_MODEL_INSTANCE_STORE_H_
@@ -10,14 +10,35 @@
  * This source file contains the \c Solution class definition
  */
 
+#include <cmath>
 #include <iostream>
-#include <deque>
 #include <utility>  // Para std::pair
 #include <algorithm>  // Para std::find_if
 #include <iomanip>
 #include "src/model/solution.h"
 
 DECLARE_uint64(number_of_allocation_experiments);
+DECLARE_string(local_search_evaluation);
+
+namespace {
+
+/// The activation waits in the cone of \c Solution::ConeComputeObjectiveFunction()
+constexpr uint8_t kInCone = 1u;
+
+/// The move changed the virtual machine, position or files of the activation
+constexpr uint8_t kConeSeed = 2u;
+
+/// The virtual machine waits in \c Solution::dirty_vms_
+constexpr uint8_t kDirtyVm = 1u;
+
+/// The allocation time of the virtual machine may have gone down
+constexpr uint8_t kRescanVm = 2u;
+
+/// How far above the objective value of the solution a move evaluated by deltas can still be taken
+/// as a possible improvement, for the rounding errors of the deltas
+constexpr double kDeltaTolerance = 1e-9;
+
+}  // namespace
 
 /**
  * Parameterised constructor.
@@ -26,9 +47,24 @@ DECLARE_uint64(number_of_allocation_experiments);
  */
 Solution::Solution(std::shared_ptr<Algorithm> algorithm)
         : algorithm_(algorithm),
-          activation_allocations_(algorithm->GetActivationSize(), std::numeric_limits<size_t>::max()),
-          file_manager_(algorithm->GetFilesSize(), algorithm->GetStorageSize(), algorithm->get_conflict_graph()),
-          activation_height_(algorithm->GetActivationSize(), -1),
+          activation_allocations_(algorithm->GetActivationSize(), kNoValue<IndexType>),
+          file_manager_(algorithm->get_instance_store().GetFileSizesInGB(),
+                        algorithm->GetStorageSize(),
+                        algorithm->get_conflict_graph()),
+          activation_finish_times_(algorithm->GetActivationSize(), 0u),
+          // Every position changes both times of its virtual machine and the allocation time of
+          // the storage of each file it reads or writes; a move sets every virtual machine once more
+          vm_timeline_(algorithm->GetVirtualMachineSize(),
+                       algorithm->GetActivationSize(),
+                       (2ul * algorithm->GetActivationSize())
+                       + algorithm->get_instance_store().GetSlotSize()
+                       + algorithm->GetVirtualMachineSize()),
+          activation_start_times_(algorithm->GetActivationSize(), 0u),
+          slot_times_(algorithm->get_instance_store().GetSlotSize(), 0u),
+          vm_queues_(algorithm->GetVirtualMachineSize()),
+          cone_flags_(algorithm->GetActivationSize(), 0u),
+          dirty_vm_flags_(algorithm->GetVirtualMachineSize(), 0u),
+          dirty_vm_times_(algorithm->GetVirtualMachineSize(), 0u),
           makespan_(std::numeric_limits<size_t>::max()),
           virtual_machine_cost_(std::numeric_limits<double>::max()),
           bucket_variable_cost_(std::numeric_limits<double>::max()),
@@ -36,26 +72,45 @@ Solution::Solution(std::shared_ptr<Algorithm> algorithm)
           activation_exposure_(std::numeric_limits<double>::max()),
           file_privacy_exposure_(std::numeric_limits<double>::max()),
           security_exposure_(algorithm_->get_maximum_security_and_privacy_exposure()) {
+    PlaceStaticFiles();
+}
+
+/**
+ * Gives the same state as the constructor without allocating, once the buffers have grown to the
+ * size of a complete schedule; the GRCH and the GRASP build one solution per iteration on it.
+ */
+void Solution::Reset() {
+    std::fill(activation_allocations_.begin(), activation_allocations_.end(), kNoValue<IndexType>);
+    activation_exposure_sum_ = 0.0;
+    file_manager_.Reset();
+    ordering_.clear();
+    std::fill(activation_finish_times_.begin(), activation_finish_times_.end(), 0u);
+    std::fill(activation_start_times_.begin(), activation_start_times_.end(), 0u);
+    vm_timeline_.Reset();
+    makespan_ = std::numeric_limits<size_t>::max();
+    virtual_machine_cost_ = std::numeric_limits<double>::max();
+    bucket_variable_cost_ = std::numeric_limits<double>::max();
+    cost_ = std::numeric_limits<double>::max();
+    activation_exposure_ = std::numeric_limits<double>::max();
+    file_privacy_exposure_ = std::numeric_limits<double>::max();
+    security_exposure_ = algorithm_->get_maximum_security_and_privacy_exposure();
+    objective_value_ = std::numeric_limits<double>::max();
+    DiscardEvaluation();
+    PlaceStaticFiles();
+}
+
+void Solution::PlaceStaticFiles() {
     // Initialize the allocation with the static files place information (VM or Bucket)
     for (size_t i = 0ul; i < algorithm_->GetFilesSize(); ++i) {
-        auto file = algorithm_->GetFilePerId(i);
-        if (auto static_file = std::dynamic_pointer_cast<StaticFile>(file)) {
-            SetFileAllocation(file->get_id(), static_file->GetFirstVm());
+        if (algorithm_->IsStaticFile(i)) {
+            SetFileAllocation(i, algorithm_->GetStaticFileStorage(i));
         }
     }
-
-    // Setting Activations Heights
-    ComputeTasksHeights(algorithm->get_id_source());
-
-    // Initialize the Activation Execution Data
-    for (auto i = 0ul; i < algorithm->GetActivationSize(); ++i) {
-        ActivationExecutionData aed{algorithm->GetActivationSize(), algorithm->GetVirtualMachineSize()};
-        activation_execution_data_.push_back(aed);
-    }
-
 }
 
 void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_ordering) {
+    const auto &instance = algorithm_->get_instance_store();
+
     for (auto index = start_of_ordering; index < ordering_.size(); index++) {
         auto activation_id = ordering_[index];
         // Initializations
@@ -65,45 +120,37 @@ void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_orderi
         size_t activation_run_time;
         size_t finish_time;
 
-        // Fetching some previous Activation Execution Data
-        for (auto vm_id = 0ul; vm_id < algorithm_->GetVirtualMachineSize(); vm_id++) {
-            auto previous_activation_id = ordering_[index - 1];
-            activation_execution_data_[activation_id].set_vm_finish_time(vm_id,
-                    activation_execution_data_[previous_activation_id].get_vm_finish_time(vm_id));
-            activation_execution_data_[activation_id].set_vm_allocation_time(vm_id,
-                    activation_execution_data_[previous_activation_id].get_vm_allocation_time(vm_id));
-        }
+        // Start from the VM times after the previous activation
+        vm_timeline_.BeginPosition(index);
 
         // Load Vm
-        auto vm = algorithm_->GetVirtualMachinePerId(activation_allocations_[activation_id]);
+        const auto &vm = algorithm_->GetVirtualMachinePerId(activation_allocations_[activation_id]);
         auto vm_id = vm->get_id();
-        auto activation = algorithm_->GetActivationPerId(activation_id);
 
         // TODO: VM finish time and VM allocation time could be within the VM object
         // Compute Activation Start Time
         // What came latter, occupation of the VM or the previous activation finish time
-        for (auto previous_activation_id: algorithm_->GetPredecessors(activation->get_id())) {
+        for (auto previous_activation_id: instance.GetPredecessors(activation_id)) {
             if (previous_activation_id == algorithm_->get_id_source()) {
                 activation_start_time = 0ul;
                 break;
             }
             activation_start_time = std::max<size_t>(
                     activation_start_time,
-                    activation_execution_data_[previous_activation_id].get_activation_finish_time());
+                    WidenIndex(activation_finish_times_[previous_activation_id]));
         }
         activation_start_time = std::max<size_t>(
                 activation_start_time,
-                activation_execution_data_[activation_id].get_vm_finish_time(vm_id));
+                vm_timeline_.get_vm_finish_time(vm_id));
 
         // Compute Activation Read Time
-        for (const auto &file: activation->get_input_files()) {
+        auto slot = instance.GetInputSlot(activation_id);
+        for (auto file_id: instance.GetInputFiles(activation_id)) {
             size_t storage_id;
-            auto file_id = file->get_id();
 
-            // TODO: This should be inside the file object, something like GetStorage()
-            if (auto static_file = std::dynamic_pointer_cast<StaticFile>(file)) {
+            if (instance.IsStaticFile(file_id)) {
                 // If the file is static, get the ID of the storage where the file is stored from its definition
-                storage_id = static_file->GetFirstVm();
+                storage_id = instance.GetStaticFileStorage(file_id);
             } else {
                 // If the file is dynamic, get the ID of the storage where the file is stored from its allocation
                 storage_id = file_manager_.get_file_allocation(file_id);
@@ -113,10 +160,8 @@ void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_orderi
                 LOG(FATAL) << "Wrong storage_id - PopulateExecutionAndAllocationsTimeVectors";
             }
 
-            auto file_storage = algorithm_->GetStoragePerId(storage_id);
-
             // Ceil of File Transfer Time + File Size * lambda
-            auto one_file_read_time = file->GetFileTransfer(file_storage->get_id(), vm->get_id());
+            auto one_file_read_time = algorithm_->GetFileTransfer(file_id, storage_id, vm_id);
 
             // If reading problem then terminate
             if (one_file_read_time == std::numeric_limits<size_t>::max()) {
@@ -124,42 +169,46 @@ void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_orderi
             }
 
             activation_read_time += one_file_read_time;
+            auto slot_time = 0ul;
 
             // If the storage is some VM (not bucket) different from the execution VM
             // Allocate the necessary VM for the reading
-            if (storage_id < algorithm_->GetVirtualMachineSize() and storage_id != vm->get_id()) {
+            if (storage_id < algorithm_->GetVirtualMachineSize() and storage_id != vm_id) {
                 if (activation_start_time != std::numeric_limits<size_t>::max()
                     && activation_read_time != std::numeric_limits<size_t>::max()) {
                     auto finish_read_time = activation_start_time + activation_read_time;
-                    activation_execution_data_[activation_id].set_vm_allocation_time(
+                    vm_timeline_.set_vm_allocation_time(
                             storage_id,
                             std::max<size_t>(
-                                    activation_execution_data_[activation_id].get_vm_allocation_time(storage_id),
+                                    vm_timeline_.get_vm_allocation_time(storage_id),
                                     finish_read_time));
+                    slot_time = finish_read_time;
                 }
             }
+            slot_times_[slot++] = NarrowIndex<TimeType>(slot_time);
         }
 
         // Compute Run time
-        activation_run_time = ceil(activation->get_time() * vm->get_slowdown());
+        activation_run_time = algorithm_->GetActivationRunTime(activation_id, vm_id);
 
         // Compute Write Time
-        auto output_files = activation->get_output_files();
-        for (const auto& output_file: output_files) {
-            auto output_file_id = output_file->get_id();
+        slot = instance.GetOutputSlot(activation_id);
+        for (auto output_file_id: instance.GetOutputFiles(activation_id)) {
             auto storage_id = file_manager_.get_file_allocation(output_file_id);
-            auto storage = algorithm_->GetStoragePerId(storage_id);
-            auto one_file_write_time = output_file->GetFileTransfer(vm->get_id(), storage->get_id());
+            auto one_file_write_time = algorithm_->GetFileTransfer(output_file_id,
+                                                                   vm_id,
+                                                                   storage_id);
 
             // If we could not Write the output_file then terminate!
             if (one_file_write_time == std::numeric_limits<size_t>::max()) {
                 LOG(FATAL) << "Something is wrong with output_file writing";
             }
 
-            DLOG(INFO) << "output_file: " << output_file->get_name();
+            DLOG(INFO) << "output_file: " << output_file_id;
             DLOG(INFO) << "one_file_write_time: " << one_file_write_time;
 
             activation_write_time += one_file_write_time;
+            auto slot_time = 0ul;
 
             // If the storage is some VM (not bucket) different from the execution VM
             // Allocate the necessary VM for the writing
@@ -172,15 +221,17 @@ void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_orderi
                             + activation_run_time + activation_write_time;
 
                     // Need to Allocate VM until output_file is writen
-                    activation_execution_data_[activation_id].set_vm_allocation_time(
+                    vm_timeline_.set_vm_allocation_time(
                             storage_id,
                             std::max<size_t>(
-                                    activation_execution_data_[activation_id].get_vm_allocation_time(storage_id),
+                                    vm_timeline_.get_vm_allocation_time(storage_id),
                                     finish_write_time));
+                    slot_time = finish_write_time;
                 } else {
                     LOG(FATAL) << "Something very very very wrong";
                 }
             }
+            slot_times_[slot++] = NarrowIndex<TimeType>(slot_time);
         }
 
         // Compute Finish Time
@@ -195,17 +246,18 @@ void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_orderi
 
         // TODO: This should be within the activation object and vm object
         // Update structures
-        activation_execution_data_[activation_id].set_activation_finish_time(finish_time);
-        activation_execution_data_[activation_id].set_vm_finish_time(vm_id, finish_time);
-        activation_execution_data_[activation_id].set_vm_allocation_time(
+        activation_start_times_[activation_id] = NarrowIndex<TimeType>(activation_start_time);
+        activation_finish_times_[activation_id] = NarrowIndex<TimeType>(finish_time);
+        vm_timeline_.set_vm_finish_time(vm_id, finish_time);
+        vm_timeline_.set_vm_allocation_time(
                 vm_id,
                 std::max<size_t>(
-                        activation_execution_data_[activation_id].get_vm_allocation_time(vm_id),
+                        vm_timeline_.get_vm_allocation_time(vm_id),
                         finish_time));
 
 
         DLOG(INFO) << "my_allocation_vm_queue[" << vm_id << "]: "
-                << activation_execution_data_[activation_id].get_vm_allocation_time(vm_id);
+                << vm_timeline_.get_vm_allocation_time(vm_id);
         DLOG(INFO) << "activation_id: " << activation_id;
         DLOG(INFO) << "vm->get_id(): " << vm_id;
         DLOG(INFO) << "activation_start_time: " << activation_start_time;
@@ -220,11 +272,10 @@ void Solution::PopulateExecutionAndAllocationsTimeVectors(size_t start_of_orderi
 double Solution::AccumulateVMCost() {
     double vm_cost = 0.0;
     for (auto i = 0ul; i < algorithm_->GetVirtualMachineSize(); ++i) {
-        auto virtual_machine = algorithm_->GetVirtualMachinePerId(i);
-        auto alloc_time = static_cast<double>(activation_execution_data_[ordering_.back()].get_vm_allocation_time(i));
+        const auto &virtual_machine = algorithm_->GetVirtualMachinePerId(i);
+        auto alloc_time = static_cast<double>(vm_timeline_.get_vm_allocation_time(i));
         vm_cost += ((alloc_time / 3600) * virtual_machine->get_cost());  // Billed per hour
-        DLOG(INFO) << "allocation_vm_queue_[" << i << "]: " << activation_execution_data_[ordering_.back()]
-                .get_vm_allocation_time(i);
+        DLOG(INFO) << "allocation_vm_queue_[" << i << "]: " << vm_timeline_.get_vm_allocation_time(i);
         DLOG(INFO) << "virtual_machine->get_cost(): " << virtual_machine->get_cost();
     }
     return vm_cost;
@@ -234,14 +285,30 @@ double Solution::AccumulateVMCost() {
 double Solution::AccumulateBucketCost() {
     double bucket_cost = 0.0;
     for (auto i = algorithm_->GetVirtualMachineSize(); i < algorithm_->GetStorageSize(); ++i) {
-        auto storage = algorithm_->GetStoragePerId(i);
+        bucket_cost += algorithm_->GetStoragePerId(i)->get_cost()
+                       * file_manager_.GetStorageSizeInGB(i);
+    }
+#ifndef NDEBUG
+    // The sizes are summed in the order the files came, so only up to the rounding
+    auto scanned_bucket_cost = ScanBucketCost();
+    if (std::abs(bucket_cost - scanned_bucket_cost) > 1e-9 * std::max(1.0, scanned_bucket_cost)) {
+        LOG(FATAL) << "Bucket cost " << bucket_cost << " kept apart from " << scanned_bucket_cost;
+    }
+#endif
+    return bucket_cost;
+}
+
+double Solution::ScanBucketCost() const {
+    double bucket_cost = 0.0;
+    for (auto i = algorithm_->GetVirtualMachineSize(); i < algorithm_->GetStorageSize(); ++i) {
+        const auto &storage = algorithm_->GetStoragePerId(i);
 
         // If the storage is not a Virtual Machine, i.e. it is a Bucket; then calculate the bucket
         // variable cost
         for (auto j = 0ul; j < algorithm_->GetFilesSize(); ++j) {
             // If the Bucket is used; then accumulate de cost and break to the next Storage
             if (file_manager_.get_file_allocation(j) == i) {
-                auto file = algorithm_->GetFilePerId(j);
+                const auto &file = algorithm_->GetFilePerId(j);
                 bucket_cost += (storage->get_cost() * file->get_size_in_GB());
             }
         }
@@ -256,22 +323,22 @@ void Solution::ComputeCost() {
 
 // Accumulate the activation exposure
 double Solution::AccumulateActivationExposure() {
+#ifndef NDEBUG
+    // The exposures are whole numbers, so their sum does not depend on the order
+    if (activation_exposure_sum_ != ScanActivationExposure()) {
+        LOG(FATAL) << "Activation exposure " << activation_exposure_sum_ << " kept apart from "
+                   << ScanActivationExposure();
+    }
+#endif
+    return activation_exposure_sum_;
+}
 
+double Solution::ScanActivationExposure() const {
     double activation_exposure = 0.0;
     for (auto i = 0ul; i < algorithm_->GetActivationSize(); ++i) {
-
-        auto activation = algorithm_->GetActivationPerId(i);
-        for (auto j = 0ul; j < activation->get_requirements().size(); ++j) {
-
-            auto virtual_machine_id = activation_allocations_[i];
-            if (virtual_machine_id != std::numeric_limits<size_t>::max()) {
-
-                auto virtual_machine = algorithm_->GetVirtualMachinePerId(virtual_machine_id);
-                if (activation->GetRequirementValue(j) > virtual_machine->GetRequirementValue(j)) {
-
-                    activation_exposure += activation->GetRequirementValue(j) - virtual_machine->GetRequirementValue(j);
-                }
-            }
+        auto virtual_machine_id = activation_allocations_[i];
+        if (virtual_machine_id != kNoValue<IndexType>) {
+            activation_exposure += algorithm_->GetActivationExposure(i, virtual_machine_id);
         }
     }
     return activation_exposure;
@@ -301,7 +368,7 @@ void Solution::ComputeConfidentialityExposure() {
 
 size_t Solution::fetch_makespan() const {
 
-    return activation_execution_data_[ordering_.back()].get_activation_finish_time();
+    return WidenIndex(activation_finish_times_[ordering_.back()]);
 }
 
 double Solution::fetch_cost() const {
@@ -325,10 +392,22 @@ double Solution::ComputeAndFetchOF() {
     return of;
 }
 
+/**
+ * The times before \c start_of_ordering are taken from the last evaluation, so the positions before
+ * it must be the same; the evaluation starts earlier when the times there are not evaluated ones,
+ * as after the construction or after an undone move.
+ *
+ * \param[in]  start_of_ordering  The first position of the ordering changed since the last
+ *                                evaluation
+ * \retval     objective_value    The objective value of the solution
+ */
 double Solution::OptimizedComputeObjectiveFunction(size_t start_of_ordering) {
     DLOG(INFO) << "Compute Optimized Objective Function";
 
+    start_of_ordering = std::max(std::min(start_of_ordering, evaluated_positions_), 1ul);
     PopulateExecutionAndAllocationsTimeVectors(start_of_ordering);
+    evaluated_positions_ = ordering_.size();
+    times_evaluated_ = true;
     ComputeCost();
     ComputeConfidentialityExposure();
 
@@ -405,9 +484,8 @@ bool Solution::checkFiles() {
     // for (auto it : data->file_map) {
     // for (auto it : algorithm_->get_file_map_per_id()) {
     for (size_t it = 0ul; it < algorithm_->GetFilesSize(); ++it) {
-        std::shared_ptr<File> file = algorithm_->GetFilePerId(it);
-
-        if (std::shared_ptr<DynamicFile> dynamic_file = std::dynamic_pointer_cast<DynamicFile>(file)) {
+        if (!algorithm_->IsStaticFile(it)) {
+            const auto &dynamic_file = algorithm_->GetFilePerId(it);
             id_storage = file_manager_.get_file_allocation(dynamic_file->get_id());
             auto f = map_file.insert(std::make_pair(id_storage, std::vector<size_t>()));
             f.first->second.push_back(dynamic_file->get_id());
@@ -435,7 +513,7 @@ bool Solution::checkFiles() {
             // Search min file (based on the size of file)
             for_each(vet_file.begin(), vet_file.end(), [&](size_t i) {
                 std::cout << i << std::endl;
-                std::shared_ptr<File> file = algorithm_->GetFilePerId(i);
+                const std::shared_ptr<File> &file = algorithm_->GetFilePerId(i);
                 std::cout << file->get_name() << std::endl;
                 if (file->get_size_in_GB() < min) {
                     min = file->get_size_in_GB();
@@ -443,7 +521,7 @@ bool Solution::checkFiles() {
                 }
             });
 
-            std::shared_ptr<File> file_min = algorithm_->GetFilePerId(min_file);
+            const std::shared_ptr<File> &file_min = algorithm_->GetFilePerId(min_file);
 
             std::cout << file_min->get_name() << std::endl;
             // MinFile will be moved to machine with more empty space
@@ -496,12 +574,12 @@ std::ostream &Solution::Write(std::ostream &os) const {
     os << std::endl;
     os << "Allocations and executions: " << std::endl;
     for (size_t i = 0ul; i < algorithm_->GetVirtualMachineSize(); ++i) {
-        os << "a[" << i << "]: \t" << activation_execution_data_[ordering_.back()].get_vm_allocation_time(i) << "\t";
+        os << "a[" << i << "]: \t" << vm_timeline_.get_vm_allocation_time(i) << "\t";
     }
 
     os << std::endl;
     for (size_t i = 0ul; i < algorithm_->GetVirtualMachineSize(); ++i) {
-        os << "x[" << i << "]: \t" << activation_execution_data_[ordering_.back()].get_vm_finish_time(i) << "\t";
+        os << "x[" << i << "]: \t" << vm_timeline_.get_vm_finish_time(i) << "\t";
     }
     os << std::endl << std::endl;
 
@@ -519,11 +597,11 @@ std::ostream &Solution::Write(std::ostream &os) const {
     os << std::endl;
     os << "Activations: " << std::endl;
     for (size_t i = 0ul; i < algorithm_->GetVirtualMachineSize(); ++i) {
-        std::shared_ptr<VirtualMachine> vm = algorithm_->GetVirtualMachinePerId(i);
+        const std::shared_ptr<VirtualMachine> &vm = algorithm_->GetVirtualMachinePerId(i);
 
         os << "**MV" << vm->get_id() + 1 << "**: \\" << std::endl;
         for (size_t j = 0ul; j < algorithm_->GetActivationSize(); ++j) {
-            std::shared_ptr<Activation> activation = algorithm_->GetActivationPerId(j);
+            const std::shared_ptr<Activation> &activation = algorithm_->GetActivationPerId(j);
             size_t virtual_machine_id = activation_allocations_[j];
 
             if (virtual_machine_id == vm->get_id()) {
@@ -536,20 +614,20 @@ std::ostream &Solution::Write(std::ostream &os) const {
     os << std::endl;
     os << "Files: " << std::endl;
     for (size_t i = 0ul; i < algorithm_->GetStorageSize(); ++i) {
-        auto storage = algorithm_->GetStoragePerId(i);
+        const auto &storage = algorithm_->GetStoragePerId(i);
 
-        if (const auto s = std::dynamic_pointer_cast<VirtualMachine>(storage)) {
-            os << "|**MV" << s->get_id() + 1 << "**| |" << std::endl;
+        if (algorithm_->IsVirtualMachine(storage->get_id())) {
+            os << "|**MV" << storage->get_id() + 1 << "**| |" << std::endl;
         } else {
             os << "|***Bucket" << storage->get_id() - algorithm_->GetVirtualMachineSize() + 1 << "***| |" << std::endl;
         }
 
         for (size_t j = 0ul; j < algorithm_->GetFilesSize(); ++j) {
-            auto file = algorithm_->GetFilePerId(j);
+            const auto &file = algorithm_->GetFilePerId(j);
             size_t storage_id;
 
-            if (std::shared_ptr<StaticFile> static_file = std::dynamic_pointer_cast<StaticFile>(file)) {
-                storage_id = static_file->GetFirstVm();
+            if (algorithm_->IsStaticFile(j)) {
+                storage_id = algorithm_->GetStaticFileStorage(j);
             } else {
                 storage_id = file_manager_.get_file_allocation(file->get_id());
             }
@@ -597,15 +675,16 @@ size_t Solution::AllocateOneOutputFileGreedily(const std::shared_ptr<Activation>
                                                const size_t run_time,
                                                const size_t partial_write_time) {
 
-    DLOG(INFO) << "Computing time for Write the File[" << file->get_id() << "] into VM[" << vm->get_id() << "]";
-    auto activation_id = activation->get_id();
+    DLOG(INFO) << "Computing time for Write the File[" << file->get_id() << "] of the Activation["
+               << activation->get_id() << "] into VM[" << vm->get_id() << "]";
     double partial_objective_value;
     double best_objective_value = std::numeric_limits<double>::max();
     size_t best_write_one_file_time = std::numeric_limits<size_t>::max();
     double best_security_exposure = std::numeric_limits<double>::max();
     size_t best_storage_id = std::numeric_limits<size_t>::max();
 
-    auto available_storages = std::vector<std::shared_ptr<Storage>>(algorithm_->GetStorageSize());
+    auto &available_storages = available_storages_;
+    available_storages.resize(algorithm_->GetStorageSize());
     for (size_t i = 0ul; i < available_storages.size(); ++i) {
         available_storages[i] = algorithm_->GetStoragePerId(i);
     }
@@ -624,7 +703,9 @@ size_t Solution::AllocateOneOutputFileGreedily(const std::shared_ptr<Activation>
             continue;
         }  // Hard-constraint
 
-        write_one_file_time = file->GetFileTransfer(vm->get_id(), storage->get_id());
+        write_one_file_time = algorithm_->GetFileTransfer(file->get_id(),
+                                                          vm->get_id(),
+                                                          storage->get_id());
 
         // 2. Calculates the File Contribution to the Cost
         double cost;
@@ -636,11 +717,12 @@ size_t Solution::AllocateOneOutputFileGreedily(const std::shared_ptr<Activation>
         virtual_machine_cost += static_cast<double>(write_one_file_time) * vm->get_cost();
 
         // Allocation cost
-        if (auto inner_vm = std::dynamic_pointer_cast<VirtualMachine>(storage)) {
+        if (algorithm_->IsVirtualMachine(storage->get_id())) {
+            const auto &inner_vm = algorithm_->GetVirtualMachinePerId(storage->get_id());
             size_t total_time = start_time + read_time + run_time + partial_write_time + write_one_file_time;
-            if (total_time > activation_execution_data_[activation_id].get_vm_allocation_time(inner_vm->get_id())) {
+            if (total_time > vm_timeline_.get_vm_allocation_time(inner_vm->get_id())) {
                 size_t diff = total_time
-                        - activation_execution_data_[activation_id].get_vm_allocation_time(inner_vm->get_id());
+                        - vm_timeline_.get_vm_allocation_time(inner_vm->get_id());
                 allocation_cost = static_cast<double>(diff) * inner_vm->get_cost();
             }
         }
@@ -697,13 +779,12 @@ size_t Solution::AllocateOneOutputFileGreedily(const std::shared_ptr<Activation>
         DLOG(INFO) << "allocation_vm_queue_: " << partial_write_time;
         DLOG(INFO) << "allocation_vm_queue_: " << best_write_one_file_time;
 
-        auto vm_allocation_time = activation_execution_data_[activation_id]
-                .get_vm_allocation_time(best_storage_id);
+        auto vm_allocation_time = vm_timeline_.get_vm_allocation_time(best_storage_id);
         auto computed_time = start_time + read_time + run_time + partial_write_time + best_write_one_file_time;
-        activation_execution_data_[activation_id].set_vm_allocation_time(best_storage_id,
+        vm_timeline_.set_vm_allocation_time(best_storage_id,
                 std::max(computed_time, vm_allocation_time));
         DLOG(INFO) << "allocation_vm_queue_[" << best_storage_id << "]: "
-                << activation_execution_data_[activation_id].get_vm_allocation_time(best_storage_id);
+                << vm_timeline_.get_vm_allocation_time(best_storage_id);
     }
 
     return best_write_one_file_time;
@@ -732,13 +813,13 @@ size_t Solution::ComputeActivationStartTime(size_t activation_id, size_t vm_id)
     size_t start_time = 0UL;
 
     for (auto previous_task_id: algorithm_->GetPredecessors(activation_id)) {
-        auto activation_finish_time = activation_execution_data_[previous_task_id].get_activation_finish_time();
+        auto activation_finish_time = WidenIndex(activation_finish_times_[previous_task_id]);
         start_time = std::max<size_t>(start_time, activation_finish_time);
     }
 
     DLOG(INFO) << "StartTime: " << start_time;
 
-    return std::max<size_t>(start_time, activation_execution_data_[activation_id].get_vm_finish_time(vm_id));
+    return std::max<size_t>(start_time, vm_timeline_.get_vm_finish_time(vm_id));
 }
 
 size_t Solution::AllocateOutputFiles(const std::shared_ptr<Activation> &activation,
@@ -748,7 +829,8 @@ size_t Solution::AllocateOutputFiles(const std::shared_ptr<Activation> &activati
                                      const size_t run_time) {
 
     auto write_time = 0ul;
-    auto output_files = activation->get_output_files();
+    auto &output_files = output_files_;
+    output_files = activation->get_output_files();
 
     // TODO: see if this behaviour is better
     // Shuffle the output files for better randomness between the solutions
@@ -762,9 +844,11 @@ size_t Solution::AllocateOutputFiles(const std::shared_ptr<Activation> &activati
             write_time += AllocateOneOutputFileGreedily(activation, file, vm, start_time, read_time, run_time,
                                                         write_time);
         } else {
-            std::shared_ptr<Storage> storage = algorithm_->GetStoragePerId(file_manager_.get_file_allocation(
-                    file->get_id()));
-            write_time = file->GetFileTransfer(vm->get_id(), storage->get_id());
+            const auto &storage = algorithm_->GetStoragePerId(
+                    file_manager_.get_file_allocation(file->get_id()));
+            write_time = algorithm_->GetFileTransfer(file->get_id(),
+                                                     vm->get_id(),
+                                                     storage->get_id());
         }
     }
 
@@ -774,7 +858,6 @@ size_t Solution::AllocateOutputFiles(const std::shared_ptr<Activation> &activati
 size_t Solution::ComputeActivationReadTime(const std::shared_ptr<Activation> &activation,
                                            const std::shared_ptr<VirtualMachine> &vm,
                                            const size_t start_time) {
-    auto activation_id = activation->get_id();
     DLOG(INFO) << "Compute Read Time of the Activation[" << activation->get_id() << "] at VM[" << vm->get_id()
                << "]";
 
@@ -783,8 +866,8 @@ size_t Solution::ComputeActivationReadTime(const std::shared_ptr<Activation> &ac
     for (const auto &file: activation->get_input_files()) {
         size_t storage_id;
 
-        if (auto static_file = std::dynamic_pointer_cast<StaticFile>(file)) {
-            storage_id = static_file->GetFirstVm();
+        if (algorithm_->IsStaticFile(file->get_id())) {
+            storage_id = algorithm_->GetStaticFileStorage(file->get_id());
         } else {
             storage_id = file_manager_.get_file_allocation(file->get_id());
         }
@@ -793,9 +876,11 @@ size_t Solution::ComputeActivationReadTime(const std::shared_ptr<Activation> &ac
             LOG(FATAL) << "Wrong storage_id - ComputeActivationReadTime";
         }
 
-        std::shared_ptr<Storage> file_vm = algorithm_->GetStoragePerId(storage_id);
+        const std::shared_ptr<Storage> &file_vm = algorithm_->GetStoragePerId(storage_id);
 
-        auto one_file_read_time = file->GetFileTransfer(file_vm->get_id(), vm->get_id());
+        auto one_file_read_time = algorithm_->GetFileTransfer(file->get_id(),
+                                                              file_vm->get_id(),
+                                                              vm->get_id());
 
         if (one_file_read_time == std::numeric_limits<size_t>::max()) {
             DLOG(INFO) << "read_time: " << one_file_read_time;
@@ -807,11 +892,11 @@ size_t Solution::ComputeActivationReadTime(const std::shared_ptr<Activation> &ac
 
             if (storage_id < algorithm_->GetVirtualMachineSize() and storage_id != vm->get_id()) {
                 auto allocation_time = std::max((start_time + read_time),
-                        activation_execution_data_[activation_id].get_vm_allocation_time(storage_id));
-                activation_execution_data_[activation_id].set_vm_allocation_time(storage_id, allocation_time);
+                        vm_timeline_.get_vm_allocation_time(storage_id));
+                vm_timeline_.set_vm_allocation_time(storage_id, allocation_time);
                 DLOG(INFO) << "storage_id";
                 DLOG(INFO) << "allocation_vm_queue_[" << storage_id << "]: "
-                        << activation_execution_data_[activation_id].get_vm_allocation_time(storage_id);
+                        << vm_timeline_.get_vm_allocation_time(storage_id);
             }
         }
     }
@@ -842,7 +927,7 @@ size_t Solution::CalculateMakespanAndAllocateOutputFiles(const std::shared_ptr<A
 
     start_time = ComputeActivationStartTime(activation->get_id(), virtual_machine->get_id());
     read_time = ComputeActivationReadTime(activation, virtual_machine, start_time);
-    run_time = std::ceil(activation->get_time() * virtual_machine->get_slowdown());
+    run_time = algorithm_->GetActivationRunTime(activation->get_id(), virtual_machine->get_id());
     write_time = AllocateOutputFiles(activation, virtual_machine, start_time, read_time, run_time);
 
     if (start_time != std::numeric_limits<size_t>::max()
@@ -860,7 +945,8 @@ size_t Solution::CalculateMakespanAndAllocateOutputFiles(const std::shared_ptr<A
 }
 
 /**
- *
+ * The soft conflicts between \c file and the files already in \c storage. \c FileManager keeps
+ * their sum for every file and storage, so this no longer depends on the number of files.
  *
  * @param storage
  * @param file
@@ -868,27 +954,9 @@ size_t Solution::CalculateMakespanAndAllocateOutputFiles(const std::shared_ptr<A
  */
 double Solution::ComputeFileSecurityExposureContribution(const std::shared_ptr<Storage> &storage,
                                                          const std::shared_ptr<File>& file) {
-    double security_exposure;
-    double privacy_exposure = 0.0;
-
-    // Accumulate the privacy_exposure
-    for (size_t i = 0ul; i < algorithm_->GetFilesSize(); ++i) {
-        size_t storage1_id = file_manager_.get_file_allocation(i);
-        
-        if (storage1_id != std::numeric_limits<size_t>::max()
-            && storage->get_id() != std::numeric_limits<size_t>::max()
-            && storage1_id == storage->get_id()) {
-            // int conflict_value = algorithm_->get_conflict_graph().ReturnConflict(i, file->get_id());
-            int conflict_value = algorithm_->get_conflict_graph()->ReturnConflict(file->get_id(), i);
-
-            if (conflict_value > 0) {
-                DLOG(INFO) << "File[" << i << "] has conflict with File[" << file->get_id() << "]";
-                privacy_exposure += conflict_value;  // Adds the penalties
-            }
-        }
-    }
-
-    security_exposure = privacy_exposure;
+    // The soft conflicts of the file with the files already in the storage, kept by FileManager
+    auto security_exposure = static_cast<double>(
+            file_manager_.GetConflictWithStorage(file->get_id(), storage->get_id()));
 
     DLOG(INFO) << "security_exposure: " << security_exposure;
 
@@ -904,7 +972,19 @@ double Solution::ComputeFileSecurityExposureContribution(const std::shared_ptr<S
 void Solution::AllocateTask(const std::shared_ptr<Activation> &activation,
                             const std::shared_ptr<VirtualMachine> &vm) {
     // Allocate Activation
-    activation_allocations_[activation->get_id()] = vm->get_id();
+    AllocateActivation(activation->get_id(), vm->get_id());
+    DiscardEvaluation();
+}
+
+void Solution::AllocateActivation(size_t activation_id, size_t vm_id) {
+    auto previous_vm_id = activation_allocations_[activation_id];
+    if (previous_vm_id != kNoValue<IndexType>) {
+        activation_exposure_sum_ -= algorithm_->GetActivationExposure(activation_id, previous_vm_id);
+    }
+    activation_allocations_[activation_id] = NarrowIndex<IndexType>(vm_id);
+    if (vm_id != kNoValue<size_t>) {
+        activation_exposure_sum_ += algorithm_->GetActivationExposure(activation_id, vm_id);
+    }
 }
 
 /**
@@ -912,6 +992,7 @@ void Solution::AllocateTask(const std::shared_ptr<Activation> &activation,
  */
 void Solution::ClearOrdering() {
     ordering_.clear();
+    DiscardEvaluation();
 }
 
 /**
@@ -919,7 +1000,8 @@ void Solution::ClearOrdering() {
  * @param id
  */
 void Solution::AddOrdering(const size_t id) {
-    ordering_.push_back(id);
+    ordering_.push_back(static_cast<IndexType>(id));
+    DiscardEvaluation();
 }
 
 /**
@@ -929,31 +1011,43 @@ void Solution::AddOrdering(const size_t id) {
  * 1. makespan
  * 2. cost
  * 3. security exposure
- * And then, return the sum of them.
+ * And then, return the sum of them, within the move that undoes the insertion.
  *
  * \param[in]  activation             Activation for which we want to find the fitness
  * \param[in]  vm               VM where the activation will be executed
- * \retval     objective_value  The objective value of the solution when inserting the \c activation
+ * \retval     move             The changes of the insertion; \c move.objectives.objective_value is the
+ *                              objective value of the solution when inserting the \c activation
  */
-double Solution::ScheduleActivation(const std::shared_ptr<Activation> &activation,
-                                    const std::shared_ptr<VirtualMachine> &vm) {
+void Solution::ScheduleActivation(const std::shared_ptr<Activation> &activation,
+                                  const std::shared_ptr<VirtualMachine> &vm,
+                                  ScheduleMove &move) {
     DLOG(INFO) << "Begin schedule the Activation[" << activation->get_id() << "] at VM[" << vm->get_id() << "]";
     auto activation_id = activation->get_id();
-    // Allocate Activation
-    activation_allocations_[activation->get_id()] = vm->get_id();
-    ordering_.push_back(activation->get_id());
-
-    // Fetching some previous Activation Execution Data
-    if (ordering_.size() > 1ul) {
-        for (auto vm_id = 0ul; vm_id < algorithm_->GetVirtualMachineSize(); vm_id++) {
-            auto previous_activation_id = ordering_[ordering_.size() - 2];
-            activation_execution_data_[activation_id].set_vm_finish_time(vm_id,
-                    activation_execution_data_[previous_activation_id].get_vm_finish_time(vm_id));
-            activation_execution_data_[activation_id].set_vm_allocation_time(vm_id,
-                    activation_execution_data_[previous_activation_id].get_vm_allocation_time(vm_id));
+    // Sized once for any activation, so the moves reused by the GRCH stop allocating
+    move.file_allocations.clear();
+    move.file_allocations.reserve(algorithm_->get_max_output_files());
+    move.vm_times.clear();
+    move.vm_times.reserve(algorithm_->GetVirtualMachineSize());
+    move.activation_id = activation_id;
+    move.vm_id = vm->get_id();
+    move.position = ordering_.size();
+    move.previous_vm_id = WidenIndex(activation_allocations_[activation_id]);
+    move.previous_finish_time = WidenIndex(activation_finish_times_[activation_id]);
+    move.previous_objectives = GetObjectives();
+    DiscardEvaluation();
+    for (const auto &file: activation->get_output_files()) {
+        if (file_manager_.get_file_allocation(file->get_id()) == std::numeric_limits<size_t>::max()) {
+            move.file_allocations.emplace_back(file->get_id(), std::numeric_limits<size_t>::max());
         }
     }
 
+    // Allocate Activation
+    AllocateActivation(activation_id, vm->get_id());
+    ordering_.push_back(static_cast<IndexType>(activation->get_id()));
+
+    // Start from the VM times after the previous activation
+    vm_timeline_.BeginPosition(ordering_.size() - 1ul);
+
     // 1. Calculates the finish_time
     size_t finish_time = CalculateMakespanAndAllocateOutputFiles(activation, vm);
 
@@ -966,15 +1060,15 @@ double Solution::ScheduleActivation(const std::shared_ptr<Activation> &activatio
 //    DLOG(INFO) << "allocation_vm_queue_[" << vm->get_id() << "]: " << vm_allocation_time_[vm->get_id()];
 //    makespan_ = activation_finish_time_[ordering_.back()];
 
-    activation_execution_data_[activation_id].set_activation_finish_time(finish_time);
-    activation_execution_data_[activation_id].set_vm_finish_time(vm->get_id(), finish_time);
-    auto allocation_time = activation_execution_data_[activation_id].get_vm_allocation_time(vm->get_id());
-    activation_execution_data_[activation_id].set_vm_allocation_time(vm->get_id(),
+    activation_finish_times_[activation_id] = NarrowIndex<TimeType>(finish_time);
+    vm_timeline_.set_vm_finish_time(vm->get_id(), finish_time);
+    auto allocation_time = vm_timeline_.get_vm_allocation_time(vm->get_id());
+    vm_timeline_.set_vm_allocation_time(vm->get_id(),
             std::max<size_t>(finish_time, allocation_time));
     DLOG(INFO) << "vm->get_id()";
     DLOG(INFO) << "allocation_vm_queue_[" << vm->get_id() << "]: "
-            << activation_execution_data_[activation_id].get_vm_allocation_time(vm->get_id());
-    makespan_ = activation_execution_data_[activation_id].get_activation_finish_time();
+            << vm_timeline_.get_vm_allocation_time(vm->get_id());
+    makespan_ = WidenIndex(activation_finish_times_[activation_id]);
 
     // 2. Calculates the cost contribution of the activation execution at the virtual machine
     DLOG(INFO) << "Calculates the cost contribution of the Virtual Machine Cost of the scheduled activation";
@@ -991,34 +1085,20 @@ double Solution::ScheduleActivation(const std::shared_ptr<Activation> &activatio
 //        DLOG(INFO) << "virtual_machine->get_cost(): " << virtual_machine->get_cost();
 //    }
     for (size_t i = 0ul; i < algorithm_->GetVirtualMachineSize(); ++i) {
-        std::shared_ptr<VirtualMachine> virtual_machine = algorithm_->GetVirtualMachinePerId(i);
-        auto vm_allocation_time = activation_execution_data_[activation_id].get_vm_allocation_time(
+        const auto &virtual_machine = algorithm_->GetVirtualMachinePerId(i);
+        auto vm_allocation_time = vm_timeline_.get_vm_allocation_time(
                 virtual_machine->get_id());
         auto alloc_time = static_cast<double>(vm_allocation_time);
 //        virtual_machine_cost += static_cast<double>(vm_allocation_time) * virtual_machine->get_cost();
         virtual_machine_cost += (alloc_time / 3600) * virtual_machine->get_cost();
 
         DLOG(INFO) << "allocation_vm_queue_[virtual_machine->get_id()]: "
-                   << activation_execution_data_[activation_id].get_vm_allocation_time(virtual_machine->get_id());
+                   << vm_timeline_.get_vm_allocation_time(virtual_machine->get_id());
         DLOG(INFO) << "virtual_machine->get_cost(): " << virtual_machine->get_cost();
     }
 
     // Accumulate the Bucket variable cost
-    for (size_t i = algorithm_->GetVirtualMachineSize(); i < algorithm_->GetStorageSize(); ++i) {
-        std::shared_ptr<Storage> storage = algorithm_->GetStoragePerId(i);
-
-        // If the storage is not a Virtual Machine, i.e. it is a Bucket; then calculate the bucket
-        // variable cost
-        for (size_t j = 0ul; j < algorithm_->GetFilesSize(); ++j) {
-            // If the Bucket is used; then accumulate de cost and break to the next Storage
-            if (file_manager_.get_file_allocation(j) == storage->get_id()) {
-                std::shared_ptr<File> file = algorithm_->GetFilePerId(j);
-                bucket_variable_cost += (storage->get_cost() * file->get_size_in_GB());
-                DLOG(INFO) << "storage->get_cost(): " << storage->get_cost();
-                DLOG(INFO) << "file->get_size_in_GB(): " << file->get_size_in_GB();
-            }
-        }
-    }
+    bucket_variable_cost = AccumulateBucketCost();
     cost_ = virtual_machine_cost + bucket_variable_cost;
 
     // 3. Calculates the security exposure
@@ -1058,38 +1138,471 @@ double Solution::ScheduleActivation(const std::shared_ptr<Activation> &activatio
     DLOG(INFO) << "Makespan " << makespan_ << ", cost " << cost_ << ", security " << security_exposure_ << ", o.f. "
                << objective_value_;
 
-    return objective_value_;
+    move.finish_time = finish_time;
+    for (auto &file_allocation: move.file_allocations) {
+        file_allocation.second = file_manager_.get_file_allocation(file_allocation.first);
+    }
+    vm_timeline_.CollectChanges(move.position, move.vm_times);
+    move.objectives = GetObjectives();
+}
+
+/**
+ * Only the last move can be undone: the activation of \c move must be the last one of the
+ * ordering.
+ *
+ * \param[in]  move  The move recorded by \c ScheduleActivation()
+ */
+void Solution::Rollback(const ScheduleMove &move) {
+    if (ordering_.size() != move.position + 1ul || ordering_.back() != move.activation_id) {
+        LOG(FATAL) << "Only the last scheduled activation can be rolled back";
+    }
+
+    SetObjectives(move.previous_objectives);
+    DiscardEvaluation();
+    for (auto it = move.file_allocations.rbegin(); it != move.file_allocations.rend(); ++it) {
+        file_manager_.RemoveFileAllocation(it->first);
+    }
+    activation_finish_times_[move.activation_id] = NarrowIndex<TimeType>(move.previous_finish_time);
+    vm_timeline_.Truncate(move.position);
+    ordering_.pop_back();
+    AllocateActivation(move.activation_id, move.previous_vm_id);
+}
+
+/**
+ * Puts back what \c ScheduleActivation() computed without computing it again, so the output files
+ * get the same storages and no random numbers are drawn.
+ *
+ * \param[in]  move  A move recorded by \c ScheduleActivation() and then rolled back
+ */
+void Solution::Redo(const ScheduleMove &move) {
+    if (ordering_.size() != move.position) {
+        LOG(FATAL) << "The move does not follow the last scheduled activation";
+    }
+
+    AllocateActivation(move.activation_id, move.vm_id);
+    ordering_.push_back(static_cast<IndexType>(move.activation_id));
+    DiscardEvaluation();
+    vm_timeline_.BeginPosition(move.position);
+    for (const auto &times: move.vm_times) {
+        vm_timeline_.set_vm_times(times);
+    }
+    activation_finish_times_[move.activation_id] = NarrowIndex<TimeType>(move.finish_time);
+    for (const auto &file_allocation: move.file_allocations) {
+        file_manager_.set_file_allocation(file_allocation.first, file_allocation.second);
+    }
+    SetObjectives(move.objectives);
+}
+
+Solution::Objectives Solution::GetObjectives() const {
+    return {makespan_,
+            virtual_machine_cost_,
+            bucket_variable_cost_,
+            cost_,
+            activation_exposure_,
+            file_privacy_exposure_,
+            security_exposure_,
+            objective_value_};
+}
+
+void Solution::SetObjectives(const Objectives &objectives) {
+    makespan_ = objectives.makespan;
+    virtual_machine_cost_ = objectives.virtual_machine_cost;
+    bucket_variable_cost_ = objectives.bucket_variable_cost;
+    cost_ = objectives.cost;
+    activation_exposure_ = objectives.activation_exposure;
+    file_privacy_exposure_ = objectives.file_privacy_exposure;
+    security_exposure_ = objectives.security_exposure;
+    objective_value_ = objectives.objective_value;
+}
+
+/**
+ * Fills the positions of the activations and reads \c --local_search_evaluation. The cone
+ * evaluation needs the times and the cost and exposure sums of the solution being searched, so
+ * they are evaluated first, keeping the objective values the solution came with.
+ */
+void Solution::PrepareLocalSearch() {
+    activation_positions_.resize(algorithm_->GetActivationSize());
+    for (size_t position = 0ul; position < ordering_.size(); ++position) {
+        activation_positions_[ordering_[position]] = static_cast<IndexType>(position);
+    }
+    files_changed_.clear();
+
+    if (FLAGS_local_search_evaluation == "full") {
+        move_evaluation_ = MoveEvaluation::kFull;
+    } else if (FLAGS_local_search_evaluation == "suffix") {
+        move_evaluation_ = MoveEvaluation::kSuffix;
+    } else if (FLAGS_local_search_evaluation == "cone") {
+        move_evaluation_ = MoveEvaluation::kCone;
+    } else {
+        LOG(FATAL) << "Unknown local search evaluation: " << FLAGS_local_search_evaluation;
+    }
+
+    if (move_evaluation_ == MoveEvaluation::kCone) {
+        auto objectives = GetObjectives();
+        if (times_evaluated_) {
+            ComputeCost();
+            ComputeConfidentialityExposure();
+        } else {
+            OptimizedComputeObjectiveFunction();
+        }
+        searched_objectives_ = GetObjectives();
+        SetObjectives(objectives);
+        vm_queues_.Build(ordering_, activation_allocations_);
+        vm_timeline_.CollectTimesBefore(1ul, vm_base_times_);
+    }
+}
+
+/**
+ * A moved activation changes its own position on; a moved file changes the first position reading
+ * or writing it. With the full evaluation the whole ordering is evaluated again.
+ *
+ * \param[in]  activation_ids  The activations moved to other virtual machines or positions
+ * \retval     position        The position the evaluation has to start from
+ */
+size_t Solution::FirstChangedPosition(std::initializer_list<size_t> activation_ids) const {
+    if (move_evaluation_ == MoveEvaluation::kFull) {
+        return 1ul;
+    }
+
+    const auto &instance = algorithm_->get_instance_store();
+    size_t position = ordering_.size();
+
+    for (auto activation_id: activation_ids) {
+        position = std::min<size_t>(position, activation_positions_[activation_id]);
+    }
+    for (const auto &file_change: files_changed_) {
+        for (auto activation_id: instance.GetFileUsers(file_change.first)) {
+            position = std::min<size_t>(position, activation_positions_[activation_id]);
+        }
+    }
+    return position;
 }
 
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "misc-no-recursion"
+double Solution::EvaluateMove(std::initializer_list<size_t> activation_ids) {
+    ++number_of_moves_;
+    move_position_ = FirstChangedPosition(activation_ids);
+    if (move_evaluation_ == MoveEvaluation::kCone) {
+        return ConeComputeObjectiveFunction(activation_ids);
+    }
+    return OptimizedComputeObjectiveFunction(move_position_);
+}
 
 /**
+ * The cone evaluation puts back the times it changed. The other evaluations leave the times of the
+ * move from its first position on, so they are not the evaluated ones of the solution anymore.
  *
+ * \param[in]  activation_ids  The activations given to \c EvaluateMove(), back at their virtual
+ *                             machines and positions
+ */
+void Solution::UndoMove(std::initializer_list<size_t> activation_ids) {
+    if (move_evaluation_ != MoveEvaluation::kCone) {
+        evaluated_positions_ = std::min(evaluated_positions_, move_position_);
+        times_evaluated_ = false;
+        return;
+    }
+
+    for (auto it = cone_changes_.rbegin(); it != cone_changes_.rend(); ++it) {
+        activation_start_times_[it->activation_id] = it->start_time;
+        activation_finish_times_[it->activation_id] = it->finish_time;
+    }
+    cone_changes_.clear();
+    for (auto it = slot_changes_.rbegin(); it != slot_changes_.rend(); ++it) {
+        slot_times_[it->first] = it->second;
+    }
+    slot_changes_.clear();
+    vm_timeline_.Undo(cone_timeline_mark_);
+    for (auto activation_id: activation_ids) {
+        vm_queues_.Remove(activation_id);
+    }
+    for (auto activation_id: activation_ids) {
+        vm_queues_.Insert(activation_id, activation_allocations_[activation_id],
+                          activation_positions_);
+    }
+}
+
+/**
+ * An activation starts after its predecessors and after the activation before it in the queue of
+ * its virtual machine, so only the activations reached from the move through successors and
+ * queues can change their times. They are timed again in the order of their positions, the cone
+ * growing only past the activations whose finish time changed. A virtual machine stays allocated
+ * until the latest of the finish times of its activations and of the reads and writes of its files,
+ * kept by slot in \c slot_times_; only the virtual machines whose slots changed get their times
+ * computed again, and only the ones whose latest slot may have gone down look at all of their
+ * slots. The times before the move stay in \c cone_changes_, \c slot_changes_ and
+ * \c vm_timeline_ for \c UndoMove(). Gives the times of
+ * \c PopulateExecutionAndAllocationsTimeVectors().
  *
- * @param node
+ * The bucket cost and the exposure are kept up to date as the files and activations move; the
+ * rent changes only for the virtual machines whose allocation time changed, so it is taken as a
+ * delta over \c searched_objectives_. When the move may improve the solution, the rent is summed
+ * again over every virtual machine, so the local searches take the same moves as with the other
+ * evaluations.
  *
- * @return
+ * \param[in]  activation_ids   The activations moved to other virtual machines or positions
+ * \retval     objective_value  The objective value of the solution
  */
-int Solution::ComputeTasksHeights(size_t node) {
-    int min = std::numeric_limits<int>::max();
-    if (activation_height_[node] != -1)
-        return activation_height_[node];
-    if (node != algorithm_->get_id_target()) {
-        for (auto i: algorithm_->GetSuccessors(node)) {
-            int value = ComputeTasksHeights(i);
-            min = std::min(value, min);
+double Solution::ConeComputeObjectiveFunction(std::initializer_list<size_t> activation_ids) {
+    const auto &instance = algorithm_->get_instance_store();
+
+    auto searched_objective_value = objective_value_;
+    auto virtual_machine_cost = searched_objectives_.virtual_machine_cost;
+
+    cone_changes_.clear();
+    slot_changes_.clear();
+    cone_timeline_mark_ = vm_timeline_.get_change_size();
+
+    // Move the activations in the queues; the ones after them get other previous activations
+    for (auto activation_id: activation_ids) {
+        AddDirtyVm(vm_queues_.get_vm(activation_id), true);
+        PushCone(vm_queues_.Remove(activation_id), false);
+    }
+    for (auto activation_id: activation_ids) {
+        auto vm_id = activation_allocations_[activation_id];
+        AddDirtyVm(vm_id, true);
+        PushCone(vm_queues_.Insert(activation_id, vm_id, activation_positions_), false);
+        PushCone(activation_id, true);
+    }
+    for (const auto &file_change: files_changed_) {
+        AddDirtyVm(file_change.second, true);
+        AddDirtyVm(file_manager_.get_file_allocation(file_change.first), true);
+        for (auto activation_id: instance.GetFileUsers(file_change.first)) {
+            PushCone(activation_id, true);
         }
+    }
+
+    // Every activation of the cone comes after the ones that delay it
+    for (auto position = move_position_; cone_size_ > 0ul; ++position) {
+        if (cone_flags_[position] != 0u) {
+            auto seed = (cone_flags_[position] & kConeSeed) != 0u;
+            cone_flags_[position] = 0u;
+            --cone_size_;
+            UpdateConeActivation(ordering_[position], seed);
+        }
+    }
+
+    for (auto vm_id: dirty_vms_) {
+        virtual_machine_cost += ComputeVmTimes(vm_id);
+    }
+    dirty_vms_.clear();
+
+    // The timeline keeps the times of the earlier positions only up to the move
+    evaluated_positions_ = std::min(evaluated_positions_, move_position_);
+
+    virtual_machine_cost_ = virtual_machine_cost;
+    bucket_variable_cost_ = AccumulateBucketCost();
+    ComputeConfidentialityExposure();
+
+    makespan_ = fetch_makespan();
+    cost_ = fetch_cost();
+    security_exposure_ = fetch_confidentiality_exposure();
+    objective_value_ = ComputeAndFetchOF();
+
+    if (objective_value_ < searched_objective_value + kDeltaTolerance) {
+        virtual_machine_cost_ = AccumulateVMCost();
+
+        cost_ = fetch_cost();
+        objective_value_ = ComputeAndFetchOF();
+    }
+
+    return objective_value_;
+}
+
+void Solution::PushCone(size_t activation_id, bool seed) {
+    if (activation_id == VmQueues::kNone) {
+        return;
+    }
+    auto &flags = cone_flags_[activation_positions_[activation_id]];
+    if ((flags & kInCone) == 0u) {
+        ++cone_size_;
+    }
+    flags |= seed ? kInCone | kConeSeed : kInCone;
+}
+
+/**
+ * Computes the times as \c PopulateExecutionAndAllocationsTimeVectors() does, from the finish
+ * times of the predecessors and of the activation before it in its queue. An activation the move
+ * did not change only starts at another time, so its finish and its slots shift with its start; a
+ * seed reads and writes its files again.
+ *
+ * \param[in]  activation_id  The activation to time again
+ * \param[in]  seed           Whether the move changed its virtual machine, position or files
+ */
+void Solution::UpdateConeActivation(size_t activation_id, bool seed) {
+    const auto &instance = algorithm_->get_instance_store();
+    auto vm_id = WidenIndex(activation_allocations_[activation_id]);
+    auto start_time = 0ul;
+
+    for (auto previous_activation_id: instance.GetPredecessors(activation_id)) {
+        if (previous_activation_id == algorithm_->get_id_source()) {
+            start_time = 0ul;
+            break;
+        }
+        start_time = std::max<size_t>(start_time,
+                                      WidenIndex(activation_finish_times_[previous_activation_id]));
+    }
+    auto previous_activation_id = vm_queues_.Previous(activation_id, activation_positions_);
+    start_time = std::max<size_t>(
+            start_time,
+            previous_activation_id == VmQueues::kNone
+            ? WidenIndex(vm_base_times_[vm_id].finish_time)
+            : WidenIndex(activation_finish_times_[previous_activation_id]));
+
+    auto previous_start_time = WidenIndex(activation_start_times_[activation_id]);
+    auto previous_finish_time = WidenIndex(activation_finish_times_[activation_id]);
+    if (!seed && start_time == previous_start_time) {
+        return;
+    }
+
+    auto input_slot = instance.GetInputSlot(activation_id);
+    auto output_slot = instance.GetOutputSlot(activation_id);
+    size_t finish_time;
+
+    if (seed) {
+        auto read_time = 0ul;
+        auto write_time = 0ul;
+        auto slot = input_slot;
+        for (auto file_id: instance.GetInputFiles(activation_id)) {
+            auto storage_id = instance.IsStaticFile(file_id)
+                              ? instance.GetStaticFileStorage(file_id)
+                              : file_manager_.get_file_allocation(file_id);
+            read_time += algorithm_->GetFileTransfer(file_id, storage_id, vm_id);
+            SetSlotTime(slot++, storage_id,
+                        storage_id < algorithm_->GetVirtualMachineSize() && storage_id != vm_id
+                        ? start_time + read_time : 0ul);
+        }
+        auto run_time = algorithm_->GetActivationRunTime(activation_id, vm_id);
+        slot = output_slot;
+        for (auto file_id: instance.GetOutputFiles(activation_id)) {
+            auto storage_id = file_manager_.get_file_allocation(file_id);
+            write_time += algorithm_->GetFileTransfer(file_id, vm_id, storage_id);
+            SetSlotTime(slot++, storage_id,
+                        storage_id < algorithm_->GetVirtualMachineSize() && storage_id != vm_id
+                        ? start_time + read_time + run_time + write_time : 0ul);
+        }
+        finish_time = start_time + read_time + run_time + write_time;
+        AddDirtyVm(vm_id, true);
     } else {
-        activation_height_[node] = algorithm_->get_height()[node];
-        return activation_height_[node];
+        // Nothing but the start changed, every time of the activation shifts with it
+        finish_time = start_time + (previous_finish_time - previous_start_time);
+        auto slot = input_slot;
+        for (auto file_id: instance.GetInputFiles(activation_id)) {
+            auto storage_id = instance.IsStaticFile(file_id)
+                              ? instance.GetStaticFileStorage(file_id)
+                              : file_manager_.get_file_allocation(file_id);
+            if (storage_id < algorithm_->GetVirtualMachineSize() && storage_id != vm_id) {
+                SetSlotTime(slot, storage_id,
+                            start_time + (WidenIndex(slot_times_[slot]) - previous_start_time));
+            }
+            ++slot;
+        }
+        slot = output_slot;
+        for (auto file_id: instance.GetOutputFiles(activation_id)) {
+            auto storage_id = file_manager_.get_file_allocation(file_id);
+            if (storage_id < algorithm_->GetVirtualMachineSize() && storage_id != vm_id) {
+                SetSlotTime(slot, storage_id,
+                            start_time + (WidenIndex(slot_times_[slot]) - previous_start_time));
+            }
+            ++slot;
+        }
+        AddDirtyVm(vm_id, finish_time < previous_finish_time
+                          && previous_finish_time >= vm_timeline_.get_vm_allocation_time(vm_id));
+        dirty_vm_times_[vm_id] = std::max(dirty_vm_times_[vm_id],
+                                          NarrowIndex<TimeType>(finish_time));
+    }
+
+    if (start_time != previous_start_time || finish_time != previous_finish_time) {
+        cone_changes_.push_back({static_cast<IndexType>(activation_id),
+                                 activation_start_times_[activation_id],
+                                 activation_finish_times_[activation_id]});
+        activation_start_times_[activation_id] = NarrowIndex<TimeType>(start_time);
+        activation_finish_times_[activation_id] = NarrowIndex<TimeType>(finish_time);
+    }
+
+    if (finish_time != previous_finish_time) {
+        for (auto next_activation_id: instance.GetSuccessors(activation_id)) {
+            PushCone(next_activation_id, false);
+        }
+        PushCone(vm_queues_.Next(activation_id, activation_positions_), false);
     }
-    std::uniform_int_distribution<> dis(algorithm_->get_height()[node], min - 1);
-    activation_height_[node] = dis(generator());
-    return activation_height_[node];
 }
 
-#pragma clang diagnostic pop
+/**
+ * A later time can only keep the storage allocated longer; an earlier one may leave it allocated
+ * until another of its slots only if the slot was the latest one.
+ *
+ * \param[in]  slot        The read or write, by slot of \c InstanceStore
+ * \param[in]  storage_id  The storage it reads from or writes to
+ * \param[in]  time        The time the read or write ends, 0 if it does not allocate the storage
+ */
+void Solution::SetSlotTime(size_t slot, size_t storage_id, size_t time) {
+    auto previous_time = WidenIndex(slot_times_[slot]);
+    if (time == previous_time) {
+        return;
+    }
+    slot_changes_.emplace_back(slot, slot_times_[slot]);
+    slot_times_[slot] = NarrowIndex<TimeType>(time);
+    if (storage_id < algorithm_->GetVirtualMachineSize()) {
+        AddDirtyVm(storage_id, previous_time >= vm_timeline_.get_vm_allocation_time(storage_id));
+        dirty_vm_times_[storage_id] = std::max(dirty_vm_times_[storage_id],
+                                               NarrowIndex<TimeType>(time));
+    }
+}
+
+void Solution::AddDirtyVm(size_t storage_id, bool rescan) {
+    if (storage_id < algorithm_->GetVirtualMachineSize()) {
+        if (dirty_vm_flags_[storage_id] == 0u) {
+            dirty_vms_.push_back(static_cast<IndexType>(storage_id));
+        }
+        dirty_vm_flags_[storage_id] |= rescan ? kDirtyVm | kRescanVm : kDirtyVm;
+    }
+}
+
+/**
+ * The virtual machine finishes with the last activation of its queue and stays allocated until
+ * then and until the latest slot of its files, as \c PopulateExecutionAndAllocationsTimeVectors()
+ * leaves it. Unless a slot may have gone down, the allocation time only grows to the latest slot
+ * the move changed.
+ *
+ * \param[in]  vm_id      The virtual machine
+ * \retval     cost_delta  How much the rent of the virtual machine changed, as \c AccumulateVMCost()
+ *                         bills it
+ */
+double Solution::ComputeVmTimes(size_t vm_id) {
+    const auto &instance = algorithm_->get_instance_store();
+    const auto &queue = vm_queues_.get_queue(vm_id);
+    auto times = vm_base_times_[vm_id];
+
+    if (!queue.empty()) {
+        times.finish_time = activation_finish_times_[queue.back()];
+        times.allocation_time = std::max(times.allocation_time, times.finish_time);
+    }
+    if ((dirty_vm_flags_[vm_id] & kRescanVm) != 0u) {
+        file_manager_.ForEachStorageFile(vm_id, [&](size_t file_id) {
+            for (auto slot: instance.GetFileUserSlots(file_id)) {
+                times.allocation_time = std::max(times.allocation_time, slot_times_[slot]);
+            }
+        });
+    } else {
+        times.allocation_time = std::max(
+                {times.allocation_time,
+                 NarrowIndex<TimeType>(vm_timeline_.get_vm_allocation_time(vm_id)),
+                 dirty_vm_times_[vm_id]});
+    }
+    dirty_vm_flags_[vm_id] = 0u;
+    dirty_vm_times_[vm_id] = 0u;
+
+    auto allocation_time = vm_timeline_.get_vm_allocation_time(vm_id);
+    if (times.finish_time != vm_timeline_.get_vm_finish_time(vm_id)
+        || times.allocation_time != allocation_time) {
+        vm_timeline_.set_vm_times(times);
+    }
+    if (times.allocation_time == allocation_time) {
+        return 0.0;
+    }
+    auto cost = algorithm_->GetVirtualMachinePerId(vm_id)->get_cost();
+    return (static_cast<double>(times.allocation_time) / 3600) * cost
+           - (static_cast<double>(allocation_time) / 3600) * cost;
+}
 
 /**
  * N1 - Swap-vm
@@ -1099,118 +1612,107 @@ int Solution::ComputeTasksHeights(size_t node) {
  */
 bool Solution::localSearchN1() {
     DLOG(INFO) << "Executing localSearchN1 local search ...";
+    const auto &instance = algorithm_->get_instance_store();
     double best_known_of = objective_value_;
     size_t best_known_makespan = makespan_;
     double best_known_cost = cost_;
     double best_known_security_exposure_ = security_exposure_;
+    PrepareLocalSearch();
     for (auto i = 1ul; i < algorithm_->GetActivationSize() - 2ul; i++) {
         for (auto j = i + 2ul; j < algorithm_->GetActivationSize() - 1ul; j++) {
             if (activation_allocations_[i] != activation_allocations_[j]) {
                 bool was_file_changed;
                 auto i_vm = activation_allocations_[i];
                 auto j_vm = activation_allocations_[j];
-                std::deque<std::pair<size_t, size_t>> files_changed;
+                files_changed_.clear();
                 // Do the swap
-                iter_swap(activation_allocations_.begin() + static_cast<long int>(i),
-                          activation_allocations_.begin() + static_cast<long int>(j));
-                auto i_activation = algorithm_->GetActivationPerId(i);
-                auto i_input_files = i_activation->get_input_files();
-                for (const auto &input_file : i_input_files) {
-                    if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(input_file)) {
-                        auto file_id = dynamic_file->get_id();
+                AllocateActivation(i, j_vm);
+                AllocateActivation(j, i_vm);
+                auto i_input_files = instance.GetInputFiles(i);
+                for (auto file_id : i_input_files) {
+                    if (!instance.IsStaticFile(file_id)) {
 //                        auto file_allocation = file_allocations_[file_id];
                         auto file_allocation = file_manager_.get_file_allocation(file_id);
                         if (file_allocation == i_vm) {
-                            auto it = std::find_if(files_changed.begin(), files_changed.end(),
+                            auto it = std::find_if(files_changed_.begin(), files_changed_.end(),
                                                    [file_id](const std::pair<size_t, size_t>& my_pair) {
                                                        return my_pair.first == file_id;
                                                    });
-                            if (it == files_changed.end()) {
+                            if (it == files_changed_.end()) {
 //                                file_allocations_[file_id] = j_vm;
 //                                file_manager_.set_file_allocation(file_id, j_vm);
                                 was_file_changed = file_manager_.ChangeFileAllocation(file_id, j_vm);
                                 if (was_file_changed) {
-                                    files_changed.emplace_back(file_id, file_allocation);
+                                    files_changed_.emplace_back(file_id, file_allocation);
                                 }
                             }
                         }
                     }
                 }
-                auto i_output_files = i_activation->get_output_files();
-                for (const auto &output_file : i_output_files) {
-                    if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(output_file)) {
-                        auto file_id = dynamic_file->get_id();
+                auto i_output_files = instance.GetOutputFiles(i);
+                for (auto file_id : i_output_files) {
+                    if (!instance.IsStaticFile(file_id)) {
 //                        auto file_allocation = file_allocations_[file_id];
                         auto file_allocation = file_manager_.get_file_allocation(file_id);
                         if (file_allocation == i_vm) {
-                            auto it = std::find_if(files_changed.begin(), files_changed.end(),
+                            auto it = std::find_if(files_changed_.begin(), files_changed_.end(),
                                                    [file_id](const std::pair<size_t, size_t>& my_pair) {
                                                        return my_pair.first == file_id;
                                                    });
-                            if (it == files_changed.end()) {
+                            if (it == files_changed_.end()) {
 //                                file_allocations_[file_id] = j_vm;
 //                                file_manager_.set_file_allocation(file_id, j_vm);
                                 was_file_changed = file_manager_.ChangeFileAllocation(file_id, j_vm);
                                 if (was_file_changed) {
-                                    files_changed.emplace_back(file_id, file_allocation);
+                                    files_changed_.emplace_back(file_id, file_allocation);
                                 }
                             }
                         }
                     }
                 }
-                auto j_activation = algorithm_->GetActivationPerId(j);
-                auto j_input_files = j_activation->get_input_files();
-                for (const auto &input_file : j_input_files) {
-                    if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(input_file)) {
-                        auto file_id = dynamic_file->get_id();
+                auto j_input_files = instance.GetInputFiles(j);
+                for (auto file_id : j_input_files) {
+                    if (!instance.IsStaticFile(file_id)) {
 //                        auto file_allocation = file_allocations_[file_id];
                         auto file_allocation = file_manager_.get_file_allocation(file_id);
                         if (file_allocation == j_vm) {
-                            auto it = std::find_if(files_changed.begin(), files_changed.end(),
+                            auto it = std::find_if(files_changed_.begin(), files_changed_.end(),
                                                    [file_id](const std::pair<size_t, size_t>& my_pair) {
                                                        return my_pair.first == file_id;
                                                    });
-                            if (it == files_changed.end()) {
+                            if (it == files_changed_.end()) {
 //                                file_allocations_[file_id] = i_vm;
 //                                file_manager_.set_file_allocation(file_id, i_vm);
                                 was_file_changed = file_manager_.ChangeFileAllocation(file_id, i_vm);
                                 if (was_file_changed) {
-                                    files_changed.emplace_back(file_id, file_allocation);
+                                    files_changed_.emplace_back(file_id, file_allocation);
                                 }
                             }
                         }
                     }
                 }
-                auto j_output_files = j_activation->get_output_files();
-                for (const auto &output_file : j_output_files) {
-                    if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(output_file)) {
-                        auto file_id = dynamic_file->get_id();
+                auto j_output_files = instance.GetOutputFiles(j);
+                for (auto file_id : j_output_files) {
+                    if (!instance.IsStaticFile(file_id)) {
 //                        auto file_allocation = file_allocations_[file_id];
                         auto file_allocation = file_manager_.get_file_allocation(file_id);
                         if (file_allocation == j_vm) {
-                            auto it = std::find_if(files_changed.begin(), files_changed.end(),
+                            auto it = std::find_if(files_changed_.begin(), files_changed_.end(),
                                                    [file_id](const std::pair<size_t, size_t>& my_pair) {
                                                        return my_pair.first == file_id;
                                                    });
-                            if (it == files_changed.end()) {
+                            if (it == files_changed_.end()) {
 //                                file_allocations_[file_id] = i_vm;
 //                                file_manager_.set_file_allocation(file_id, i_vm);
                                 was_file_changed = file_manager_.ChangeFileAllocation(file_id, i_vm);
                                 if (was_file_changed) {
-                                    files_changed.emplace_back(file_id, file_allocation);
+                                    files_changed_.emplace_back(file_id, file_allocation);
                                 }
                             }
                         }
                     }
                 }
-//                ComputeObjectiveFunction();
-                //
-//                auto it = std::find_if(ordering_.begin(), ordering_.end(), [&](size_t elem) {
-//                    return (elem == ordering_[i]) || (elem == ordering_[j]);
-//                });
-//                auto index = std::distance(ordering_.begin(), it);
-//                OptimizedComputeObjectiveFunction(index);
-                OptimizedComputeObjectiveFunction();
+                EvaluateMove({i, j});
                 DLOG(INFO) << "... localSearchN1 : " << objective_value_ << " < " << best_known_of
                            << std::endl;
                 if (objective_value_ < best_known_of) {
@@ -1222,21 +1724,18 @@ bool Solution::localSearchN1() {
                 }
 
                 // Return elements
-                iter_swap(activation_allocations_.begin() + static_cast<long int>(i),
-                          activation_allocations_.begin() + static_cast<long int>(j));
-                while (!files_changed.empty()) {
-                    auto my_pair = files_changed.front();
+                AllocateActivation(i, i_vm);
+                AllocateActivation(j, j_vm);
+                for (const auto &my_pair: files_changed_) {
 //                    file_allocations_[my_pair.first] = my_pair.second;
 //                    file_manager_.set_file_allocation(my_pair.first, my_pair.second);
                     was_file_changed = file_manager_.ChangeFileAllocation(my_pair.first, my_pair.second);
                     if (!was_file_changed) {
                         LOG(FATAL) << "Makes no sense, file should be able to move back";
                     }
-                    files_changed.pop_front();
                 }
-                //
-//                OptimizedComputeObjectiveFunction(index);
-//                OptimizedComputeObjectiveFunction();
+                files_changed_.clear();
+                UndoMove({i, j});
                 objective_value_ = best_known_of;
                 makespan_ = best_known_makespan;
                 cost_ = best_known_cost;
@@ -1259,22 +1758,19 @@ bool Solution::localSearchN2() {
     size_t best_known_makespan = makespan_;
     double best_known_cost = cost_;
     double best_known_security_exposure_ = security_exposure_;
+    const auto &height = algorithm_->get_height();
+    PrepareLocalSearch();
     // for each task, do
     for (auto i = 1ul; i < algorithm_->GetActivationSize() - 2ul; i++) {
         auto task_i = ordering_[i];
         for (auto j = i + 2ul; j < algorithm_->GetActivationSize() - 1ul; j++) {
             auto task_j = ordering_[j];
-            if (activation_height_[task_i] == activation_height_[task_j]) {
+            if (height[task_i] == height[task_j]) {
                 // Do the swap
                 iter_swap(ordering_.begin() + static_cast<long int>(i), ordering_.begin() + static_cast<long int>(j));
-//                ComputeObjectiveFunction();
-//
-//                auto it = std::find_if(ordering_.begin(), ordering_.end(), [&](size_t elem) {
-//                    return (elem == ordering_[i]) || (elem == ordering_[j]);
-//                });
-//                auto index = std::distance(ordering_.begin(), it);
-//                OptimizedComputeObjectiveFunction(index);
-                OptimizedComputeObjectiveFunction();
+                activation_positions_[task_i] = static_cast<IndexType>(j);
+                activation_positions_[task_j] = static_cast<IndexType>(i);
+                EvaluateMove({task_i, task_j});
                 DLOG(INFO) << "new objective value " << objective_value_ << " i " << i << " j " << j << std::endl;
                 if (objective_value_ < best_known_of) {
                     DLOG(INFO) << "... localSearchN2 : " << objective_value_ << " < " << best_known_of
@@ -1285,10 +1781,9 @@ bool Solution::localSearchN2() {
                 }
                 // Return elements
                 iter_swap(ordering_.begin() + static_cast<long int>(i), ordering_.begin() + static_cast<long int>(j));
-                //
-//                OptimizedComputeObjectiveFunction(index);
-//                ComputeObjectiveFunction();
-//                OptimizedComputeObjectiveFunction();
+                activation_positions_[task_i] = static_cast<IndexType>(i);
+                activation_positions_[task_j] = static_cast<IndexType>(j);
+                UndoMove({task_i, task_j});
                 objective_value_ = best_known_of;
                 makespan_ = best_known_makespan;
                 cost_ = best_known_cost;
@@ -1310,70 +1805,62 @@ bool Solution::localSearchN2() {
 bool Solution::localSearchN3() {
 
     DLOG(INFO) << "Executing localSearchN3 local search ...";
+    const auto &instance = algorithm_->get_instance_store();
     double best_known_of = objective_value_;
     size_t best_known_makespan = makespan_;
     double best_known_cost = cost_;
     double best_known_security_exposure_ = security_exposure_;
+    PrepareLocalSearch();
     for (auto i = 1ul; i < algorithm_->GetActivationSize() - 1ul; ++i) {
         bool was_file_changed;
-        std::deque<std::pair<size_t, size_t>> files_changed;
+        files_changed_.clear();
         auto old_vm_id = activation_allocations_[i];
         for (auto new_vm_id = 0ul; new_vm_id < algorithm_->GetVirtualMachineSize(); new_vm_id++) {
             if (old_vm_id != new_vm_id) {
-                activation_allocations_[i] = new_vm_id;
-                auto i_activation = algorithm_->GetActivationPerId(i);
-                auto i_input_files = i_activation->get_input_files();
-                for (const auto &input_file : i_input_files) {
-                    if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(input_file)) {
-                        auto file_id = dynamic_file->get_id();
+                AllocateActivation(i, new_vm_id);
+                auto i_input_files = instance.GetInputFiles(i);
+                for (auto file_id : i_input_files) {
+                    if (!instance.IsStaticFile(file_id)) {
 //                        auto file_allocation = file_allocations_[file_id];
                         auto file_allocation = file_manager_.get_file_allocation(file_id);
                         if (file_allocation == old_vm_id) {
-                            auto it = std::find_if(files_changed.begin(), files_changed.end(),
+                            auto it = std::find_if(files_changed_.begin(), files_changed_.end(),
                                                    [file_id](const std::pair<size_t, size_t>& my_pair) {
                                                        return my_pair.first == file_id;
                                                    });
-                            if (it == files_changed.end()) {
+                            if (it == files_changed_.end()) {
 //                                file_allocations_[file_id] = old_vm_id;
 //                                file_manager_.set_file_allocation(file_id, old_vm_id);
                                 was_file_changed = file_manager_.ChangeFileAllocation(file_id, new_vm_id);
                                 if (was_file_changed) {
-                                    files_changed.emplace_back(file_id, file_allocation);
+                                    files_changed_.emplace_back(file_id, file_allocation);
                                 }
                             }
                         }
                     }
                 }
-                auto i_output_files = i_activation->get_output_files();
-                for (const auto &output_file : i_output_files) {
-                    if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(output_file)) {
-                        auto file_id = dynamic_file->get_id();
+                auto i_output_files = instance.GetOutputFiles(i);
+                for (auto file_id : i_output_files) {
+                    if (!instance.IsStaticFile(file_id)) {
 //                        auto file_allocation = file_allocations_[file_id];
                         auto file_allocation = file_manager_.get_file_allocation(file_id);
                         if (file_allocation == old_vm_id) {
-                            auto it = std::find_if(files_changed.begin(), files_changed.end(),
+                            auto it = std::find_if(files_changed_.begin(), files_changed_.end(),
                                                    [file_id](const std::pair<size_t, size_t>& my_pair) {
                                                        return my_pair.first == file_id;
                                                    });
-                            if (it == files_changed.end()) {
+                            if (it == files_changed_.end()) {
 //                                file_allocations_[file_id] = old_vm_id;
 //                                file_manager_.set_file_allocation(file_id, old_vm_id);
                                 was_file_changed = file_manager_.ChangeFileAllocation(file_id, new_vm_id);
                                 if (was_file_changed) {
-                                    files_changed.emplace_back(file_id, file_allocation);
+                                    files_changed_.emplace_back(file_id, file_allocation);
                                 }
                             }
                         }
                     }
                 }
-//                ComputeObjectiveFunction();
-                //
-//                auto it = std::find_if(ordering_.begin(), ordering_.end(), [&](size_t elem) {
-//                    return elem == ordering_[i];
-//                });
-//                auto index = std::distance(ordering_.begin(), it);
-//                OptimizedComputeObjectiveFunction(index);
-                OptimizedComputeObjectiveFunction();
+                EvaluateMove({i});
 //                makespan_ = of_makespan;
 //                cost_ = of_cost;
 //                security_exposure_ = of_security_exposure;
@@ -1387,20 +1874,17 @@ bool Solution::localSearchN3() {
                     return true;
                 }
                 // Change back
-                activation_allocations_[i] = old_vm_id;
-                while (!files_changed.empty()) {
-                    auto my_pair = files_changed.front();
+                AllocateActivation(i, old_vm_id);
+                for (const auto &my_pair: files_changed_) {
 //            file_allocations_[my_pair.first] = my_pair.second;
 //            file_manager_.set_file_allocation(my_pair.first, my_pair.second);
                     was_file_changed = file_manager_.ChangeFileAllocation(my_pair.first, my_pair.second);
                     if (!was_file_changed) {
                         LOG(FATAL) << "Makes no sense, file should be able to move back";
                     }
-                    files_changed.pop_front();
                 }
-                //
-//                OptimizedComputeObjectiveFunction(index);
-//                OptimizedComputeObjectiveFunction();
+                files_changed_.clear();
+                UndoMove({i});
                 objective_value_ = best_known_of;
                 makespan_ = best_known_makespan;
                 cost_ = best_known_cost;
@@ -20,17 +20,21 @@
 #include <limits>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 #include <boost/algorithm/string.hpp>
+#include <initializer_list>
 #include <memory>
 
+#include "src/common/index_types.h"
 #include "src/common/my_random.h"
 #include "src/model/dynamic_file.h"
 #include "src/model/static_file.h"
 #include "src/solution/algorithm.h"
 #include "src/model/activation.h"
-#include "src/model/activation_execution_data.h"
 #include "src/model/file_manager.h"
+#include "src/model/vm_queues.h"
+#include "src/model/vm_timeline.h"
 
 /// Forward declaration of the class Algorithm, needed because of the circular reference
 class Algorithm;
@@ -47,9 +51,65 @@ class VirtualMachine;
  */
 class Solution {
 public:
+    /// The objective values of a solution
+    struct Objectives {
+        size_t makespan;
+        double virtual_machine_cost;
+        double bucket_variable_cost;
+        double cost;
+        double activation_exposure;
+        double file_privacy_exposure;
+        double security_exposure;
+        double objective_value;
+    };
+
+    /// Everything \c ScheduleActivation() changed, to undo it with \c Rollback() and to make it
+    /// again with \c Redo()
+    struct ScheduleMove {
+        /// The scheduled activation
+        size_t activation_id = std::numeric_limits<size_t>::max();
+
+        /// The virtual machine executing it
+        size_t vm_id = std::numeric_limits<size_t>::max();
+
+        /// Its position in the ordering
+        size_t position = 0ul;
+
+        /// Its virtual machine before the move
+        size_t previous_vm_id = std::numeric_limits<size_t>::max();
+
+        /// Its finish time before the move
+        size_t previous_finish_time = 0ul;
+
+        /// Its finish time
+        size_t finish_time = 0ul;
+
+        /// The output files placed by the move and their storages, in the order they were placed
+        std::vector<std::pair<size_t, size_t>> file_allocations;
+
+        /// The times of the virtual machines changed by the move
+        std::vector<VmTimeline::VmTimes> vm_times;
+
+        /// The objective values before the move
+        Objectives previous_objectives{};
+
+        /// The objective values after the move
+        Objectives objectives{};
+    };
+
     /// Constructor declaration
     explicit Solution(std::shared_ptr<Algorithm> algorithm);
 
+    /// Copy constructor
+    Solution(const Solution &) = default;
+
+    /// Move constructor, takes the buffers of the other solution
+    Solution(Solution &&) noexcept = default;
+
+    /// Go back to the solution just constructed, with only the static files placed, reusing the
+    /// memory of the buffers
+    void Reset();
+
     ///
     double OptimizedComputeObjectiveFunction(size_t start_of_ordering = 1ul);
 
@@ -68,16 +128,28 @@ public:
     /// Getter for \c objective_value_
     [[nodiscard]] double get_objective_value() const { return objective_value_; }
 
+    /// Getter for \c number_of_moves_
+    [[nodiscard]] size_t get_number_of_moves() const { return number_of_moves_; }
+
     /// Adds a Storage to a File
     void SetFileAllocation(size_t position, size_t storage_id) {
         file_manager_.set_file_allocation(position, storage_id);
+        DiscardEvaluation();
     }
 
     /// Calculate de Objective Function of the solution
     double ObjectiveFunction(bool check_storage = true, bool check_sequence = false);
 
-    /// Schedule the \c activation to be executed at \c virtual_machine
-    double ScheduleActivation(const std::shared_ptr<Activation> &activation, const std::shared_ptr<VirtualMachine> &vm);
+    /// Schedule the \c activation to be executed at \c virtual_machine, recording it in \c move
+    void ScheduleActivation(const std::shared_ptr<Activation> &activation,
+                            const std::shared_ptr<VirtualMachine> &vm,
+                            ScheduleMove &move);
+
+    /// Undo \c move, the last \c ScheduleActivation() or \c Redo()
+    void Rollback(const ScheduleMove &move);
+
+    /// Make \c move again after it was rolled back
+    void Redo(const ScheduleMove &move);
 
     /// Schedule the \c activation to be executed at \c virtual_machine
     void AllocateTask(const std::shared_ptr<Activation> &, const std::shared_ptr<VirtualMachine> &);
@@ -91,9 +163,6 @@ public:
     /// Check the files
     inline bool checkFiles();
 
-    ///
-    int ComputeTasksHeights(size_t node);
-
     ///
     void PopulateExecutionAndAllocationsTimeVectors(size_t start_of_ordering = 1ul);
 
@@ -118,10 +187,10 @@ public:
     ///
     double AccumulateVMCost();
 
-    ///
+    /// The bucket cost, from the size of the files of every bucket kept by \c FileManager
     double AccumulateBucketCost();
 
-    ///
+    /// The exposure of the activations on their virtual machines, kept by \c AllocateActivation()
     double AccumulateActivationExposure();
 
     ///
@@ -139,12 +208,24 @@ public:
     /// Copy operator
     Solution &operator=(const Solution &) = default;
 
+    /// Move operator, takes the buffers of the other solution
+    Solution &operator=(Solution &&) noexcept = default;
+
     /// Concatenation operator
     friend std::ostream &operator<<(std::ostream &os, const Solution &a) {
         return a.Write(os);
     }
 
 protected:
+    /// Place the static files at their storages
+    void PlaceStaticFiles();
+
+    /// The current objective values
+    [[nodiscard]] Objectives GetObjectives() const;
+
+    /// Replace the objective values
+    void SetObjectives(const Objectives &objectives);
+
     /// Write this object to the output stream
     std::ostream &Write(std::ostream &os) const;
 
@@ -176,6 +257,66 @@ protected:
     size_t CalculateMakespanAndAllocateOutputFiles(const std::shared_ptr<Activation> &,
                                                    const std::shared_ptr<VirtualMachine> &);
 
+    /// How the local searches evaluate their moves
+    enum class MoveEvaluation {
+        kFull,    ///< Simulate the whole ordering again
+        kSuffix,  ///< Simulate the ordering again from the first position the move changes
+        kCone     ///< Time again only what the move can delay, cost and exposure by deltas
+    };
+
+    /// Forget the evaluated times, after a change made out of the evaluation
+    void DiscardEvaluation() {
+        evaluated_positions_ = 0ul;
+        times_evaluated_ = false;
+    }
+
+    /// Fill \c activation_positions_ and get the evaluation of the moves ready
+    void PrepareLocalSearch();
+
+    /// The first position of the ordering whose times change when the activations
+    /// \c activation_ids and the files in \c files_changed_ move
+    [[nodiscard]] size_t FirstChangedPosition(std::initializer_list<size_t> activation_ids) const;
+
+    /// Compute the objective value after the activations \c activation_ids and the files in
+    /// \c files_changed_ moved
+    double EvaluateMove(std::initializer_list<size_t> activation_ids);
+
+    /// Put the times back as they were before \c EvaluateMove(), once the move is undone
+    void UndoMove(std::initializer_list<size_t> activation_ids);
+
+    /// Compute the objective value timing again only the activations the move of
+    /// \c activation_ids and of the files in \c files_changed_ can delay
+    double ConeComputeObjectiveFunction(std::initializer_list<size_t> activation_ids);
+
+    /// Add the activation \c activation_id to the cone of the move; \c seed if the move changed
+    /// its virtual machine, position or files
+    void PushCone(size_t activation_id, bool seed);
+
+    /// Time again the activation \c activation_id of the cone
+    void UpdateConeActivation(size_t activation_id, bool seed);
+
+    /// Set the time the read or write \c slot keeps the storage \c storage_id allocated
+    void SetSlotTime(size_t slot, size_t storage_id, size_t time);
+
+    /// Mark the times of the storage \c storage_id to be computed again, if it is a virtual
+    /// machine; with \c rescan its allocation time is taken again from all of its reads and writes
+    void AddDirtyVm(size_t storage_id, bool rescan);
+
+    /// Compute again the finish and allocation times of the virtual machine \c vm_id; returns how
+    /// much its cost changed
+    double ComputeVmTimes(size_t vm_id);
+
+    /// Put the activation \c activation_id on the virtual machine \c vm_id, or on none with
+    /// \c kNoValue, keeping \c activation_exposure_sum_
+    void AllocateActivation(size_t activation_id, size_t vm_id);
+
+    /// The bucket cost summed over every bucket and file, to check \c AccumulateBucketCost()
+    [[nodiscard]] double ScanBucketCost() const;
+
+    /// The activation exposure summed over every activation, to check
+    /// \c AccumulateActivationExposure()
+    [[nodiscard]] double ScanActivationExposure() const;
+
     /// Compute the file contribution to the security exposure
     double ComputeFileSecurityExposureContribution(const std::shared_ptr<Storage> &storage,
                                                    const std::shared_ptr<File>& file);
@@ -184,19 +325,94 @@ protected:
     std::shared_ptr<Algorithm> algorithm_;
 
     /// Allocation of task in theirs VM
-    std::vector<size_t> activation_allocations_;
+    std::vector<IndexType> activation_allocations_;
+
+    /// Sum of the exposures of the allocated activations on their virtual machines
+    double activation_exposure_sum_ = 0.0;
 
     ///
     FileManager file_manager_;
 
     /// Order of the allocated tasks
-    std::vector<size_t> ordering_;
+    std::vector<IndexType> ordering_;
+
+    /// Finish time of every activation
+    std::vector<TimeType> activation_finish_times_;
+
+    /// Auxiliary data, the VM times along \c ordering_; helps recalculate important information in
+    /// case of modifications, and swaps
+    VmTimeline vm_timeline_;
+
+    /// The position of every activation in \c ordering_, filled by the local searches
+    std::vector<IndexType> activation_positions_;
+
+    /// Number of leading positions of \c ordering_ whose times in \c vm_timeline_ and
+    /// \c activation_finish_times_ are the evaluated ones of the current solution; the evaluation
+    /// resumes from there
+    size_t evaluated_positions_ = 0ul;
+
+    /// Whether \c activation_start_times_, \c activation_finish_times_ and the current times of
+    /// \c vm_timeline_ are the evaluated ones of the current solution
+    bool times_evaluated_ = false;
+
+    /// Start time of every activation, as evaluated
+    std::vector<TimeType> activation_start_times_;
+
+    /// The time every read and write keeps its storage allocated, by slot of \c InstanceStore; 0
+    /// when the storage is a bucket or the virtual machine of the activation
+    std::vector<TimeType> slot_times_;
 
-    /// The height of each task in terms of dependencies
-    std::vector<int> activation_height_;
+    /// How the local searches evaluate their moves, from \c --local_search_evaluation
+    MoveEvaluation move_evaluation_ = MoveEvaluation::kSuffix;
 
-    /// Auxiliary data, helps recalculate important information in case of modifications, and swaps
-    std::vector<ActivationExecutionData> activation_execution_data_;
+    /// The first position changed by the move being evaluated
+    size_t move_position_ = 0ul;
+
+    /// The activations of every virtual machine, kept by the cone evaluation
+    VmQueues vm_queues_;
+
+    /// The times of the virtual machines before the first position after the source
+    std::vector<VmTimeline::VmTimes> vm_base_times_;
+
+    /// Number of activations of the cone waiting to be timed again
+    size_t cone_size_ = 0ul;
+
+    /// Whether the activation at every position waits in the cone, and whether it is a seed of the
+    /// move
+    std::vector<uint8_t> cone_flags_;
+
+    /// The start and finish times of the activations timed again by the cone evaluation
+    struct ConeChange {
+        IndexType activation_id;
+        TimeType start_time;
+        TimeType finish_time;
+    };
+
+    /// The times of the activations before the cone evaluation changed them, in order
+    std::vector<ConeChange> cone_changes_;
+
+    /// The virtual machines whose times the cone evaluation computes again
+    std::vector<IndexType> dirty_vms_;
+
+    /// Whether every virtual machine is in \c dirty_vms_, and whether its allocation time has to
+    /// be taken again from all of its reads and writes
+    std::vector<uint8_t> dirty_vm_flags_;
+
+    /// The latest time a read or write of the move keeps every virtual machine allocated
+    std::vector<TimeType> dirty_vm_times_;
+
+    /// The slots of \c slot_times_ before the cone evaluation changed them, in order
+    std::vector<std::pair<size_t, TimeType>> slot_changes_;
+
+    /// The changes of \c vm_timeline_ before the cone evaluation
+    size_t cone_timeline_mark_ = 0ul;
+
+    /// The cost and exposure sums of the solution the local search started from, the base of the
+    /// deltas of the cone evaluation
+    Objectives searched_objectives_{};
+
+    /// Number of neighbors evaluated by the local searches
+    size_t number_of_moves_ = 0ul;
 
     /// Makespan of the solution, the total execution time
     size_t makespan_{};
@@ -221,6 +437,16 @@ protected:
 
     /// Objective value based on \c makespan_, \c cost_ and \c security_exposure_
     double objective_value_ = std::numeric_limits<double>::max();
+
+    /// The files moved by the neighbor being tried by the local searches and their previous
+    /// storages, kept between the neighbors so they do not allocate
+    std::vector<std::pair<size_t, size_t>> files_changed_;
+
+    /// The storages in the order \c AllocateOneOutputFileGreedily() tries them
+    std::vector<std::shared_ptr<Storage>> available_storages_;
+
+    /// The output files in the order \c AllocateOutputFiles() places them
+    std::vector<std::shared_ptr<File>> output_files_;
 };
 
 
@@ -26,7 +26,7 @@
 class StaticFile : public File {
 public:
     /// Parametrised constructor
-    explicit StaticFile(const size_t id, const std::string &name, const double size) :
+    explicit StaticFile(const size_t id, std::string_view name, const double size) :
             File(id, name, size) {}
 
     ///
@@ -38,6 +38,9 @@ public:
     /// Getter the first virtual machine from the list vms_
     [[nodiscard]] size_t GetFirstVm() const { return vms_[0]; }
 
+    /// Getter for the virtual machines hosting this file
+    [[nodiscard]] const std::vector<size_t> &get_vms() const { return vms_; }
+
     ///
     friend std::ostream &operator<<(std::ostream &os, const StaticFile &a) {
         return a.Write(os);
@@ -38,14 +38,20 @@ public:
     [[nodiscard]] size_t get_id() const { return id_; }
 
     /// Getter for name_
-//  const std::string &get_name() const { return name_; }
+    [[nodiscard]] const std::string &get_name() const { return name_; }
 
     /// Getter for storage_
     [[nodiscard]] double get_storage() const { return storage_; }
 
     /// Getter for bandwidth_
+    [[nodiscard]] double get_bandwidth() const { return bandwidth_; }
+
+    /// Getter for bandwidth_in_GBps_
     [[nodiscard]] double get_bandwidth_in_GBps() const { return bandwidth_in_GBps_; }
 
+    /// Getter for type_id_
+    [[nodiscard]] int get_type_id() const { return type_id_; }
+
     /// Adds a requiremnt value
     void AddRequirement(double requirement) { requirements_.push_back(static_cast<int>(requirement)); }
 
@@ -0,0 +1,70 @@
+/**
+ * \file src/model/transfer_time_model.h
+ * \brief Contains the \c TransferTimeModel class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c TransferTimeModel class, which computes the time to move a file
+ * between two storages
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_MODEL_TRANSFER_TIME_MODEL_H_
+#define APPROXIMATE_SOLUTIONS_SRC_MODEL_TRANSFER_TIME_MODEL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "src/model/storage.h"
+
+/**
+ * \class TransferTimeModel transfer_time_model.h "src/model/transfer_time_model.h"
+ * \brief The transfer times of the files, from one table of links shared by all of them
+ *
+ * The time to move a file between two different storages is the file size over the bandwidth of
+ * the slowest of the two, rounded up; it takes one unit of time inside the same storage. Only the
+ * S×S link bandwidths are kept, so the memory does not grow with the number of files.
+ */
+class TransferTimeModel {
+public:
+    /// Fills the link bandwidths of every pair of \c storages
+    void Redefine(const std::vector<std::shared_ptr<Storage>> &storages) {
+        storage_size_ = storages.size();
+        links_.resize(storage_size_ * storage_size_);
+        for (auto line = 0ul; line < storage_size_; line++) {
+            for (auto column = 0ul; column < storage_size_; column++) {
+                links_[(line * storage_size_) + column] = std::min<double>(
+                        storages[line]->get_bandwidth_in_GBps(),
+                        storages[column]->get_bandwidth_in_GBps());
+            }
+        }
+    }
+
+    /// Time to move \c size_in_GB from the storage \c origin_id (line) to \c target_id (column)
+    [[nodiscard]] size_t GetFileTransfer(double size_in_GB,
+                                         size_t origin_id,
+                                         size_t target_id) const {
+        if (origin_id == target_id) {
+            return 1ul;
+        }
+        auto link = links_[(origin_id * storage_size_) + target_id];
+        return static_cast<size_t>(std::ceil(size_in_GB / link));
+    }
+
+    /// Getter for the number of storages
+    [[nodiscard]] size_t get_storage_size() const { return storage_size_; }
+
+private:
+    /// Number of storages
+    size_t storage_size_ = 0ul;
+
+    /// The bandwidth, in GBps, of the link between every pair of storages, line by line
+    std::vector<double> links_;
+};  // end of class TransferTimeModel
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_MODEL_TRANSFER_TIME_MODEL_H_
@@ -38,6 +38,7 @@ public:
                    int type_id) :
             Storage(id, std::move(name), storage, bandwidth, type_id),
             slowdown_(slowdown),
+            cost_per_hour_(cost),
             cost_(cost / 3600.0) {}
 
 
@@ -48,6 +49,9 @@ public:
         return slowdown_;
     }
 
+    /// Getter for cost_per_hour_
+    [[nodiscard]] double get_cost_per_hour() const { return cost_per_hour_; }
+
     /// Getter for cost_
     [[nodiscard]] double get_cost() const { return cost_; }
 
@@ -84,6 +88,9 @@ protected:
     ///
     double slowdown_;
 
+    /// Cost per hour, as read from the cluster file
+    double cost_per_hour_;
+
     /// Cost
     double cost_;
 };
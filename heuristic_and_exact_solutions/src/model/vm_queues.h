@@ -0,0 +1,118 @@
+/**
+ * \file src/model/vm_queues.h
+ * \brief Contains the \c VmQueues class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c VmQueues class, the activations of every virtual machine in the
+ * order they run
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_MODEL_VM_QUEUES_H_
+#define APPROXIMATE_SOLUTIONS_SRC_MODEL_VM_QUEUES_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "src/common/index_types.h"
+
+/**
+ * \class VmQueues vm_queues.h "src/model/vm_queues.h"
+ * \brief The activations of every virtual machine, sorted by their positions in the ordering
+ *
+ * An activation starts after the one before it in the queue of its virtual machine, so these are
+ * the activations a change of finish time delays besides the successors. The positions are not
+ * kept here; every lookup takes the positions of the activations in the ordering.
+ */
+class VmQueues {
+public:
+    /// No activation, before the first one or after the last one of a queue
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    /// Constructor for \c vm_size virtual machines
+    explicit VmQueues(size_t vm_size) : queues_(vm_size) {}
+
+    /// Fill the queues with the activations of \c ordering allocated in \c allocations
+    void Build(const std::vector<IndexType> &ordering, const std::vector<IndexType> &allocations) {
+        for (auto &queue: queues_) {
+            queue.clear();
+        }
+        queue_vms_.assign(allocations.size(), kNoValue<IndexType>);
+        for (auto activation_id: ordering) {
+            auto vm_id = allocations[activation_id];
+            if (vm_id != kNoValue<IndexType>) {
+                queues_[vm_id].push_back(activation_id);
+                queue_vms_[activation_id] = vm_id;
+            }
+        }
+    }
+
+    /// The virtual machine whose queue has the activation \c activation_id
+    [[nodiscard]] size_t get_vm(size_t activation_id) const {
+        return WidenIndex(queue_vms_[activation_id]);
+    }
+
+    /// The activations of the virtual machine \c vm_id
+    [[nodiscard]] const std::vector<IndexType> &get_queue(size_t vm_id) const {
+        return queues_[vm_id];
+    }
+
+    /// Take the activation \c activation_id out of its queue; returns the activation after it
+    size_t Remove(size_t activation_id) {
+        auto &queue = queues_[queue_vms_[activation_id]];
+        auto it = queue.erase(std::find(queue.begin(), queue.end(), activation_id));
+        queue_vms_[activation_id] = kNoValue<IndexType>;
+        return it == queue.end() ? kNone : WidenIndex(*it);
+    }
+
+    /// Put the activation \c activation_id in the queue of \c vm_id at its position; returns the
+    /// activation after it
+    size_t Insert(size_t activation_id, size_t vm_id, const std::vector<IndexType> &positions) {
+        auto &queue = queues_[vm_id];
+        auto it = queue.insert(queue.begin() + Find(queue, positions[activation_id], positions),
+                               static_cast<IndexType>(activation_id));
+        queue_vms_[activation_id] = static_cast<IndexType>(vm_id);
+        ++it;
+        return it == queue.end() ? kNone : WidenIndex(*it);
+    }
+
+    /// The activation before \c activation_id in its queue
+    [[nodiscard]] size_t Previous(size_t activation_id,
+                                  const std::vector<IndexType> &positions) const {
+        const auto &queue = queues_[queue_vms_[activation_id]];
+        auto index = Find(queue, positions[activation_id], positions);
+        return index == 0l ? kNone : WidenIndex(queue[static_cast<size_t>(index - 1l)]);
+    }
+
+    /// The activation after \c activation_id in its queue
+    [[nodiscard]] size_t Next(size_t activation_id, const std::vector<IndexType> &positions) const {
+        const auto &queue = queues_[queue_vms_[activation_id]];
+        auto index = static_cast<size_t>(Find(queue, positions[activation_id], positions)) + 1ul;
+        return index == queue.size() ? kNone : WidenIndex(queue[index]);
+    }
+
+private:
+    /// Index in \c queue of the first activation not before the position \c position
+    static long Find(const std::vector<IndexType> &queue,
+                     IndexType position,
+                     const std::vector<IndexType> &positions) {
+        return std::lower_bound(queue.begin(), queue.end(), position,
+                                [&positions](IndexType activation_id, IndexType value) {
+                                    return positions[activation_id] < value;
+                                }) - queue.begin();
+    }
+
+    /// The activations of every virtual machine, sorted by position
+    std::vector<std::vector<IndexType>> queues_;
+
+    /// The virtual machine whose queue has every activation
+    std::vector<IndexType> queue_vms_;
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_MODEL_VM_QUEUES_H_
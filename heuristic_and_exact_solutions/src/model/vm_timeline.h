@@ -0,0 +1,164 @@
+/**
+ * \file src/model/vm_timeline.h
+ * \brief Contains the \c VmTimeline class declaration
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c VmTimeline class, the finish and allocation times of the
+ * virtual machines along the ordering of a solution
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_MODEL_VM_TIMELINE_H_
+#define APPROXIMATE_SOLUTIONS_SRC_MODEL_VM_TIMELINE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "src/common/index_types.h"
+
+/**
+ * \class VmTimeline vm_timeline.h "src/model/vm_timeline.h"
+ * \brief The times of the virtual machines after every position of the ordering
+ *
+ * Only the times after the last position are kept. Every change records the previous times of
+ * its virtual machine, and every position records where its changes start, so going back to the
+ * times after any earlier position undoes the changes of the following ones. The memory grows with
+ * the number of changes, not with the number of positions times the number of virtual machines.
+ */
+class VmTimeline {
+public:
+    /// The times of a virtual machine
+    struct VmTimes {
+        IndexType vm_id;
+        TimeType finish_time;
+        TimeType allocation_time;
+    };
+
+    /// Constructor for \c vm_size virtual machines, all of them free at time 0, with room for
+    /// \c position_size positions and \c change_size changes, so recording them never allocates
+    VmTimeline(size_t vm_size, size_t position_size, size_t change_size)
+            : vm_finish_time_(vm_size, 0u), vm_allocation_time_(vm_size, 0u) {
+        changes_.reserve(change_size);
+        position_offsets_.reserve(position_size);
+    }
+
+    /// Free all the virtual machines again, keeping the memory of the changes
+    void Reset() {
+        std::fill(vm_finish_time_.begin(), vm_finish_time_.end(), 0u);
+        std::fill(vm_allocation_time_.begin(), vm_allocation_time_.end(), 0u);
+        changes_.clear();
+        position_offsets_.clear();
+    }
+
+    /// Go back to the times after the position \c position - 1 and start the changes of \c position
+    void BeginPosition(size_t position) {
+        Truncate(position);
+        while (position_offsets_.size() <= position) {
+            position_offsets_.push_back(changes_.size());
+        }
+    }
+
+    /// Undo the changes of the positions from \c position on
+    void Truncate(size_t position) {
+        while (position_offsets_.size() > position) {
+            Undo(position_offsets_.back());
+            position_offsets_.pop_back();
+        }
+    }
+
+    /// Put in \c times the times of every virtual machine before the position \c position
+    void CollectTimesBefore(size_t position, std::vector<VmTimes> &times) const {
+        times.resize(vm_finish_time_.size());
+        for (size_t vm_id = 0ul; vm_id < times.size(); ++vm_id) {
+            times[vm_id] = {static_cast<IndexType>(vm_id),
+                            vm_finish_time_[vm_id],
+                            vm_allocation_time_[vm_id]};
+        }
+        for (auto i = changes_.size(); i > position_offsets_[position]; --i) {
+            times[changes_[i - 1ul].vm_id] = changes_[i - 1ul];
+        }
+    }
+
+    /// Append to \c times the current times of every virtual machine changed by \c position and
+    /// the following positions
+    void CollectChanges(size_t position, std::vector<VmTimes> &times) const {
+        auto first = times.size();
+        for (auto i = position_offsets_[position]; i < changes_.size(); ++i) {
+            auto vm_id = changes_[i].vm_id;
+            auto found = std::find_if(times.begin() + static_cast<long>(first), times.end(),
+                                      [vm_id](const VmTimes &t) { return t.vm_id == vm_id; });
+            if (found == times.end()) {
+                times.push_back({vm_id, vm_finish_time_[vm_id], vm_allocation_time_[vm_id]});
+            }
+        }
+    }
+
+    /// The time the virtual machine \c vm_id finishes its last activation
+    [[nodiscard]] size_t get_vm_finish_time(size_t vm_id) const {
+        return WidenIndex(vm_finish_time_[vm_id]);
+    }
+
+    /// Change the finish time of the virtual machine \c vm_id
+    void set_vm_finish_time(size_t vm_id, size_t time) {
+        Record(vm_id);
+        vm_finish_time_[vm_id] = NarrowIndex<TimeType>(time);
+    }
+
+    /// The time the virtual machine \c vm_id is allocated for
+    [[nodiscard]] size_t get_vm_allocation_time(size_t vm_id) const {
+        return WidenIndex(vm_allocation_time_[vm_id]);
+    }
+
+    /// Change the allocation time of the virtual machine \c vm_id
+    void set_vm_allocation_time(size_t vm_id, size_t time) {
+        Record(vm_id);
+        vm_allocation_time_[vm_id] = NarrowIndex<TimeType>(time);
+    }
+
+    /// Change both times of the virtual machine \c times.vm_id
+    void set_vm_times(const VmTimes &times) {
+        Record(times.vm_id);
+        vm_finish_time_[times.vm_id] = times.finish_time;
+        vm_allocation_time_[times.vm_id] = times.allocation_time;
+    }
+
+    /// Number of changes recorded, where \c Undo() can go back to
+    [[nodiscard]] size_t get_change_size() const { return changes_.size(); }
+
+    /// Restore the times before the change \c offset, the most recent ones first
+    void Undo(size_t offset) {
+        while (changes_.size() > offset) {
+            const auto &change = changes_.back();
+            vm_finish_time_[change.vm_id] = change.finish_time;
+            vm_allocation_time_[change.vm_id] = change.allocation_time;
+            changes_.pop_back();
+        }
+    }
+
+private:
+    /// Keep the times of \c vm_id before changing them
+    void Record(size_t vm_id) {
+        changes_.push_back({static_cast<IndexType>(vm_id),
+                            vm_finish_time_[vm_id],
+                            vm_allocation_time_[vm_id]});
+    }
+
+    /// Finish time of each Virtual Machine after the last position
+    std::vector<TimeType> vm_finish_time_;
+
+    /// Total allocation time needed for each VM after the last position
+    std::vector<TimeType> vm_allocation_time_;
+
+    /// The previous times of every change, in the order of the changes
+    std::vector<VmTimes> changes_;
+
+    /// The first change of every position
+    std::vector<size_t> position_offsets_;
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_MODEL_VM_TIMELINE_H_
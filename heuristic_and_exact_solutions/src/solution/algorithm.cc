@@ -13,10 +13,23 @@
 
 #include "src/solution/algorithm.h"
 
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <limits>
+#include <thread>
+#include "src/common/byte_source.h"
+#include "src/common/conflict_sampler.h"
+#include "src/common/instance_image.h"
+#include "src/common/mapped_file.h"
+#include "src/common/parallel.h"
+#include "src/common/text_reader.h"
+#include "src/solution/compiler.h"
+#include "src/solution/evaluation_benchmark.h"
 #include "src/solution/grch.h"
 #include "src/solution/grasp.h"
+#include "src/solution/parse_benchmark.h"
 #include "src/solution/cplex.h"
 #include "heft.h"
 
@@ -24,8 +37,7 @@ Algorithm::Algorithm() {
     conflict_graph_ = std::make_shared<ConflictGraph>();
 }
 
-void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
-                                  std::unordered_map<std::string, std::shared_ptr<File>> &file_map_per_name) {
+void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file) {
     DLOG(INFO) << "Reading Activations and Files from input file [" + tasks_and_files_file + "]" ;
 
     if (!std::filesystem::exists(tasks_and_files_file)) {
@@ -35,24 +47,39 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
     size_t task_size;
     size_t file_size;
     size_t requirement_size;
-    std::unordered_map<std::string, std::shared_ptr<Activation>> task_map_per_name_;
 
     // Reading file
-    std::string line;
-    std::ifstream in_file(tasks_and_files_file);
+    TextReader in_file(tasks_and_files_file);
+    std::string_view line;
+
+    // Every name must be interned with the ID of its file or activation
+    auto intern = [&in_file](NameTable &names, std::string_view name, size_t id, const char *what) {
+        if (names.Intern(name) != id) {
+            LOG(FATAL) << in_file.get_path() << ":" << in_file.get_line_number() << ": duplicated "
+                       << what << " \"" << name << "\"";
+        }
+        return names.get_name(id);
+    };
+    auto find = [&in_file](const NameTable &names, std::string_view name, const char *what) {
+        auto id = names.Find(name);
+        if (id == NameTable::kNotFound) {
+            LOG(FATAL) << in_file.get_path() << ":" << in_file.get_line_number() << ": unknown "
+                       << what << " \"" << name << "\"";
+        }
+        return id;
+    };
 
     // Get number of tasks and number of files
-    getline(in_file, line);
+    line = in_file.ExpectLine("the header");
     DLOG(INFO) << "Head: " << line;
-    std::vector<std::string> tokens;
-    boost::split(tokens, line, boost::is_any_of(" "));
-
-    static_file_size_ = stoul(tokens[0]);
-    dynamic_file_size_ = stoul(tokens[1]);
-    task_size = stoul(tokens[2]) + 2;  // Adding two tasks (source and target)
-    requirement_size = stoul(tokens[3]);
-    makespan_max_ = stod(tokens[4]);
-    budget_max_ = stod(tokens[5]);
+    LineTokenizer tokens(in_file, line);
+
+    static_file_size_ = tokens.Next<size_t>("the number of static files");
+    dynamic_file_size_ = tokens.Next<size_t>("the number of dynamic files");
+    task_size = tokens.Next<size_t>("the number of activations") + 2;  // Adding two tasks (source and target)
+    requirement_size = tokens.Next<size_t>("the number of requirements");
+    makespan_max_ = tokens.Next<double>("the maximum makespan");
+    budget_max_ = tokens.Next<double>("the maximum budget");
     file_size = static_file_size_ + dynamic_file_size_;
 
     DLOG(INFO) << "static_file_size_: " << static_file_size_;
@@ -63,65 +90,59 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
     DLOG(INFO) << "budget_max_: " << budget_max_;
     DLOG(INFO) << "file_size_: " << file_size;
 
-    getline(in_file, line);  // Reading blank line
+    in_file.ExpectLine("a blank line");  // Reading blank line
 
     // Reading information about requirements
     for (size_t i = 0; i < requirement_size; i++) {
-        getline(in_file, line);
+        line = in_file.ExpectLine("a requirement");
         DLOG(INFO) << "Requirement: " << line;
 
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
+        LineTokenizer strs(in_file, line);
 
-        size_t id = stoul(strs[0]);
-        double max_value = stod(strs[1]);
+        size_t id = strs.Next<size_t>("the requirement id");
+        double max_value = strs.Next<double>("the requirement maximum value");
         Requirement my_requirement = Requirement(id, max_value);
         requirements_.push_back(my_requirement);
         DLOG(INFO) << my_requirement;
     }
 
-    getline(in_file, line);  // reading blank line
+    in_file.ExpectLine("a blank line");  // reading blank line
 
     files_.reserve(file_size);
-    file_map_per_name.reserve(file_size);
+    file_names_.Reserve(file_size);
 
     // Reading information about static files
     for (size_t i = 0ul; i < static_file_size_; i++) {
-        getline(in_file, line);
+        line = in_file.ExpectLine("a static file");
         DLOG(INFO) << "File: " << line;
 
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
-        auto my_file_name = strs[0];
-        auto my_file_size = stod(strs[1]);
+        LineTokenizer strs(in_file, line);
+        auto my_file_name = intern(file_names_, strs.NextToken("the file name"), i, "file");
+        auto my_file_size = strs.Next<double>("the file size");
 
         DLOG(INFO) << "file_name: " << my_file_name;
         DLOG(INFO) << "file_size: " << my_file_size;
 
-        std::shared_ptr<File> my_staticFile = std::make_shared<StaticFile>(i, my_file_name, my_file_size);
+        auto my_staticFile = std::make_shared<StaticFile>(i, my_file_name, my_file_size);
 
-        for (size_t j = 0; j < stoul(strs[2]); ++j) {
-            auto msf = std::dynamic_pointer_cast<StaticFile>(my_staticFile);
-            msf->AddVm(stoul(strs[3 + j]));
+        auto number_of_vms = strs.Next<size_t>("the number of virtual machines");
+        for (size_t j = 0; j < number_of_vms; ++j) {
+            my_staticFile->AddVm(strs.Next<size_t>("a virtual machine id"));
         }
 
         DLOG(INFO) << *my_staticFile;
 
         files_.push_back(my_staticFile);
-        auto mfn = std::string(my_file_name);
-        auto pair = std::make_pair(mfn, my_staticFile);
-        file_map_per_name.insert(pair);
     }
 
     // Reading information about dynamic files
     for (size_t i = static_file_size_; i < static_file_size_ + dynamic_file_size_; i++) {
-        getline(in_file, line);
+        line = in_file.ExpectLine("a dynamic file");
         DLOG(INFO) << "File: " << line;
 
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
-        const std::string my_file_name = strs[0];
-        auto my_file_size = stod(strs[1]);
+        LineTokenizer strs(in_file, line);
+        auto my_file_name = intern(file_names_, strs.NextToken("the file name"), i, "file");
+        auto my_file_size = strs.Next<double>("the file size");
 
         DLOG(INFO) << "file_name: " << my_file_name;
         DLOG(INFO) << "file_size: " << my_file_size;
@@ -131,42 +152,38 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
         DLOG(INFO) << *my_dynamicFile;
 
         files_.push_back(my_dynamicFile);
-        auto mfn = std::string(my_file_name);
-        auto pair = std::make_pair(mfn, my_dynamicFile);
-        file_map_per_name.insert(pair);
     }
 
-    getline(in_file, line);  // reading blank line
+    in_file.ExpectLine("a blank line");  // reading blank line
 
     activations_.reserve(task_size);
-    task_map_per_name_.reserve(task_size);
+    activation_tags_.Reserve(task_size);
 
     // Reading information about tasks
     id_source_ = 0;
     id_target_ = task_size - 1;
 
-    std::shared_ptr<Activation> source_task = std::make_shared<Activation>(id_source_, "source", "SOURCE", 0.0);
-    std::shared_ptr<Activation> target_task = std::make_shared<Activation>(id_target_, "target", "TARGET", 0.0);
+    std::shared_ptr<Activation> source_task = std::make_shared<Activation>(
+            id_source_, intern(activation_tags_, "source", id_source_, "activation"),
+            activation_names_.get_name(activation_names_.Intern("SOURCE")), 0.0);
 
     for (size_t i = 0; i < requirement_size; ++i) {
         source_task->AddRequirement(0);
-        target_task->AddRequirement(0);
     }
 
     activations_.push_back(source_task);
 
     for (size_t i = 1; i < task_size - 1; i++) {
-        getline(in_file, line);
+        line = in_file.ExpectLine("an activation");
         DLOG(INFO) << "Activation: " << line;
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
+        LineTokenizer strs(in_file, line);
 
         // Get task info
-        auto tag = strs[0];
-        std::string task_name = strs[1];
-        auto base_time = stod(strs[2]);
-        auto in_size = stoul(strs[3]);
-        auto out_size = stoul(strs[4]);
+        auto tag = intern(activation_tags_, strs.NextToken("the activation tag"), i, "activation");
+        auto task_name = activation_names_.get_name(activation_names_.Intern(strs.NextToken("the activation name")));
+        auto base_time = strs.Next<double>("the activation time");
+        auto in_size = strs.Next<size_t>("the number of input files");
+        auto out_size = strs.Next<size_t>("the number of output files");
 
         DLOG(INFO) << "tag: " << tag;
         DLOG(INFO) << "task_name: " << task_name;
@@ -177,27 +194,27 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
         std::shared_ptr<Activation> my_task = std::make_shared<Activation>(i, tag, task_name, base_time);
 
         // Adding requirement to the task
-        for (size_t j = 5ul; j < 5ul + requirement_size; ++j) {
-            auto requirement_value = stod(strs[j]);
+        for (size_t j = 0ul; j < requirement_size; ++j) {
+            auto requirement_value = strs.Next<double>("a requirement value");
             my_task->AddRequirement(static_cast<int>(requirement_value));
         }
 
         // Reading input files
         for (size_t j = 0; j < in_size; j++) {
-            getline(in_file, line);
+            line = in_file.ExpectLine("an input file");
             DLOG(INFO) << "Input file: " << line;
 
-            std::shared_ptr<File> my_file(file_map_per_name.find(line)->second);
+            std::shared_ptr<File> my_file(files_[find(file_names_, line, "file")]);
 
             my_task->AddInputFile(my_file);
         }
 
         // Reading output files
         for (size_t j = 0; j < out_size; j++) {
-            getline(in_file, line);
+            line = in_file.ExpectLine("an output file");
             DLOG(INFO) << "Output file: " << line;
 
-            auto my_file(file_map_per_name.find(line)->second);
+            auto my_file(files_[find(file_names_, line, "file")]);
 
             auto index = my_task->AddOutputFile(my_file);
 
@@ -212,18 +229,22 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
         }
 
         activations_.push_back(my_task);
-        task_map_per_name_.insert(std::make_pair(tag, my_task));
 
         DLOG(INFO) << my_task;
     }
 
-    getline(in_file, line);  // reading blank line
+    in_file.ExpectLine("a blank line");  // reading blank line
 
     // Update Source and Target tasks
-    activations_.push_back(target_task);
+    std::shared_ptr<Activation> target_task = std::make_shared<Activation>(
+            id_target_, intern(activation_tags_, "target", id_target_, "activation"),
+            activation_names_.get_name(activation_names_.Intern("TARGET")), 0.0);
 
-    task_map_per_name_.insert(std::make_pair("source", source_task));
-    task_map_per_name_.insert(std::make_pair("target", target_task));
+    for (size_t i = 0; i < requirement_size; ++i) {
+        target_task->AddRequirement(0);
+    }
+
+    activations_.push_back(target_task);
 
     successors_.resize(task_size, std::vector<size_t>());
 
@@ -233,26 +254,25 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
 
     // Reading successors graph information
     for (size_t i = 0; i < task_size - 2; i++) {
-        getline(in_file, line);  // Reading parent task
+        line = in_file.ExpectLine("a parent activation");  // Reading parent task
 
         DLOG(INFO) << "Parent: " << line;
 
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
-        auto task_tag = strs[0];
-        auto number_of_successors = stoi(strs[1]);
+        LineTokenizer strs(in_file, line);
+        auto task_id = find(activation_tags_, strs.NextToken("the parent activation tag"), "activation");
+        auto number_of_successors = strs.Next<int>("the number of children");
 
         std::vector<size_t> children;
         // Reading children task
         for (int j = 0; j < number_of_successors; j++) {
-            getline(in_file, line);
+            line = in_file.ExpectLine("a child activation");
 
             DLOG(INFO) << "Child: " << line;
 
-            auto child_task = task_map_per_name_.find(line)->second;
+            auto child_id = find(activation_tags_, line, "activation");
 
-            children.push_back(child_task->get_id());
-            aux[child_task->get_id()] = 0;
+            children.push_back(child_id);
+            aux[child_id] = 0;
         }
 
         // Target task
@@ -260,9 +280,7 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
             children.push_back(id_target_);
         }
 
-        auto task = task_map_per_name_.find(task_tag)->second;
-
-        successors_[task->get_id()] = children;
+        successors_[task_id] = children;
     }
 
     // Add synthetic source task
@@ -274,15 +292,6 @@ void Algorithm::ReadTasksAndFiles(const std::string &tasks_and_files_file,
         }
     }
 
-    predecessors_.resize(task_size, std::vector<size_t>());
-
-    for (auto i = 0ul; i < successors_.size(); ++i) {
-        for (auto successor_id: successors_[i]) {
-            predecessors_[successor_id].push_back(i);
-        }
-    }
-
-    in_file.close();
 }
 
 void Algorithm::ReadCluster(const std::string &cluster) {
@@ -295,51 +304,53 @@ void Algorithm::ReadCluster(const std::string &cluster) {
     size_t vm_size;
 
     // Reading file
-    std::string line;
-    std::ifstream in_cluster(cluster);
-    std::vector<std::string> tokens;
+    TextReader in_cluster(cluster);
+    std::string_view line;
 
-    getline(in_cluster, line);
+    line = in_cluster.ExpectLine("the header");
 
     DLOG(INFO) << "Head: " << line;
 
-    boost::split(tokens, line, boost::is_any_of(" "));
+    LineTokenizer tokens(in_cluster, line);
 
-    size_t number_of_requirements = stoul(tokens[1]);
+    tokens.NextToken("the number of providers");
+    size_t number_of_requirements = tokens.Next<size_t>("the number of requirements");
 
-    getline(in_cluster, line);  // ignore line
+    in_cluster.ExpectLine("a blank line");  // ignore line
 
     size_t storage_id = 0ul;
 
-    getline(in_cluster, line);
+    line = in_cluster.ExpectLine("a provider");
     DLOG(INFO) << "Provider: " << line;
 
-    std::vector<std::string> strs1;
-    boost::split(strs1, line, boost::is_any_of(" "));
+    LineTokenizer strs1(in_cluster, line);
 
-    vm_size = stoul(strs1[4]);
-    size_t bucket_size = stoul(strs1[5]);
+    strs1.NextToken("the provider id");
+    strs1.NextToken("the provider name");
+    strs1.NextToken("the provider period");
+    strs1.NextToken("the maximum number of virtual machines");
+    vm_size = strs1.Next<size_t>("the number of virtual machines");
+    size_t bucket_size = strs1.Next<size_t>("the number of buckets");
 
     // Reading VMs information
     for (auto j = 0ul; j < vm_size; j++) {
-        getline(in_cluster, line);
+        line = in_cluster.ExpectLine("a virtual machine");
         DLOG(INFO) << "VM: " << line;
 
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
+        LineTokenizer strs(in_cluster, line);
 
-        int type_id = stoi(strs[0]);
-        std::string vm_name = strs[1];
-        double slowdown = stod(strs[2]);
-        double storage = stod(strs[3]) * 1024;  // GB to MB
-        double bandwidth = stod(strs[4]);
-        double cost = stod(strs[5]);
+        int type_id = strs.Next<int>("the virtual machine type");
+        std::string vm_name(strs.NextToken("the virtual machine name"));
+        double slowdown = strs.Next<double>("the slowdown");
+        double storage = strs.Next<double>("the storage") * 1024;  // GB to MB
+        double bandwidth = strs.Next<double>("the bandwidth");
+        double cost = strs.Next<double>("the cost");
 
         auto my_vm = std::make_shared<VirtualMachine>(storage_id, vm_name, slowdown, storage, cost, bandwidth, type_id);
 
         // Adding requirement to the task
-        for (size_t l = 6ul; l < 6ul + number_of_requirements; ++l) {
-            auto requirement_value = stod(strs[l]);
+        for (size_t l = 0ul; l < number_of_requirements; ++l) {
+            auto requirement_value = strs.Next<double>("a requirement value");
             my_vm->AddRequirement(requirement_value);
         }
 
@@ -351,25 +362,24 @@ void Algorithm::ReadCluster(const std::string &cluster) {
 
     // Reading Buckets information
     for (auto j = 0ul; j < bucket_size; j++) {
-        getline(in_cluster, line);
+        line = in_cluster.ExpectLine("a bucket");
         DLOG(INFO) << "Bucket: " << line;
 
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
+        LineTokenizer strs(in_cluster, line);
 
-        int type_id = stoi(strs[0]);
-        std::string name = strs[1];
-        double storage = stod(strs[2]) * 1024;  // GB to MB
-        double bandwidth = stod(strs[3]);
+        int type_id = strs.Next<int>("the bucket type");
+        std::string name(strs.NextToken("the bucket name"));
+        double storage = strs.Next<double>("the storage") * 1024;  // GB to MB
+        double bandwidth = strs.Next<double>("the bandwidth");
         size_t number_of_intervals = 1ul;
-        double cost = stod(strs[4]);
+        double cost = strs.Next<double>("the cost");
 
         auto my_bucket = std::make_shared<Bucket>(storage_id, name, storage, cost, bandwidth, type_id,
                                                   number_of_intervals);
 
         // Adding requirement to the bucket
-        for (size_t l = 5ul; l < 5ul + number_of_requirements; ++l) {
-            auto requirement_value = stod(strs[l]);
+        for (size_t l = 0ul; l < number_of_requirements; ++l) {
+            auto requirement_value = strs.Next<double>("a requirement value");
             my_bucket->AddRequirement(requirement_value);
         }
 
@@ -378,45 +388,157 @@ void Algorithm::ReadCluster(const std::string &cluster) {
         DLOG(INFO) << my_bucket;
         ++bucket_size_;
     }
-    in_cluster.close();
 }
 
-void Algorithm::ReadConflictGraph(const std::string &conflict_graph,
-                                  std::unordered_map<std::string, std::shared_ptr<File>> &file_map_per_name) {
-    DLOG(INFO) << "Reading Conflict Graph from input file [" + conflict_graph + "]" ;
-    std::string line;
-    std::vector<std::string> tokens;
+void Algorithm::ReadConflictGraph(const std::string &conflict_graph) {
+    ConflictGraphTokens tokens;
+
+    TokenizeConflictGraph(conflict_graph, tokens);
+    ResolveConflictGraph(tokens);
+}
 
-    std::ifstream in_conflict_graph(conflict_graph);
+/**
+ * Maps the conflict graph file and tokenizes it in blocks of consecutive lines, one block per
+ * thread. The file names are kept as views into the mapping until they can be resolved.
+ *
+ * \param[in]  conflict_graph  Name of the Conflict Graph input file
+ * \param[out] tokens          The mapping and the tokenized lines of each block
+ */
+void Algorithm::TokenizeConflictGraph(const std::string &conflict_graph, ConflictGraphTokens &tokens) {
+    DLOG(INFO) << "Reading Conflict Graph from input file [" + conflict_graph + "]" ;
 
-    if (!in_conflict_graph.is_open()) {
+    if (!std::filesystem::exists(conflict_graph)) {
         LOG(FATAL) << "Conflict graph [" + conflict_graph + "] doesn't exist";
     }
 
+    tokens.path = conflict_graph;
+
+    const char *data;
+    size_t size;
+    ByteSource source(conflict_graph);
+
+    // A compressed graph is decompressed in memory; a plain one is mapped
+    if (source.get_compression() != ByteSource::Compression::kNone) {
+        source.ReadAll(tokens.buffer);
+        data = tokens.buffer.data();
+        size = tokens.buffer.size();
+    } else {
+        tokens.file = std::make_unique<MappedFile>(conflict_graph);
+
+        if (!tokens.file->is_open()) {
+            if (std::filesystem::file_size(conflict_graph) != 0ul) {
+                LOG(FATAL) << "Conflict graph [" + conflict_graph + "] could not be read";
+            }
+            return;  // An empty graph
+        }
+        data = tokens.file->data();
+        size = tokens.file->size();
+    }
+    size_t number_of_blocks = NumberOfWorkers(size, 1ul << 20);
+
+    // Every block starts right after a line break
+    std::vector<size_t> block_begin(number_of_blocks + 1ul, size);
+    block_begin[0] = 0ul;
+    for (size_t block = 1ul; block < number_of_blocks; ++block) {
+        auto nominal = std::max(size * block / number_of_blocks, block_begin[block - 1ul]);
+        auto line_break = static_cast<const char *>(std::memchr(data + nominal, '\n', size - nominal));
+        block_begin[block] = line_break == nullptr ? size : static_cast<size_t>(line_break - data) + 1ul;
+    }
+
+    // The line numbers are only needed by the error messages, but they must be known up front
+    std::vector<size_t> first_line(number_of_blocks, 0ul);
+    ParallelFor(number_of_blocks, number_of_blocks, [&](size_t, size_t begin, size_t end) {
+        for (auto block = begin; block < end; ++block) {
+            first_line[block] = static_cast<size_t>(
+                    std::count(data + block_begin[block], data + block_begin[block + 1ul], '\n'));
+        }
+    });
+    for (size_t block = 0ul, lines = 0ul; block < number_of_blocks; ++block) {
+        std::swap(first_line[block], lines);
+        lines += first_line[block];
+    }
+
+    tokens.blocks.resize(number_of_blocks);
+    ParallelFor(number_of_blocks, number_of_blocks, [&](size_t, size_t begin, size_t end) {
+        for (auto block = begin; block < end; ++block) {
+            std::string_view text(data + block_begin[block], block_begin[block + 1ul] - block_begin[block]);
+            auto line_number = first_line[block];
+            auto &block_tokens = tokens.blocks[block];
+
+            while (!text.empty()) {
+                auto line_end = std::min(text.find('\n'), text.size());
+                auto line = text.substr(0ul, line_end);
+
+                text.remove_prefix(std::min(line_end + 1ul, text.size()));
+                ++line_number;
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1ul);
+                }
+
+                LineTokenizer strs(conflict_graph, line_number, line);
+
+                if (strs.AtEnd()) {
+                    continue;
+                }
+
+                ConflictToken token{};
+                token.first_file = strs.NextToken("the first file");
+                token.second_file = strs.NextToken("the second file");
+                token.value = static_cast<int>(strs.Next<double>("the conflict value"));
+                token.line_number = line_number;
+                block_tokens.push_back(token);
+            }
+        }
+    });
+}
+
+/**
+ * Resolves the file names of the tokenized conflict graph, one block per thread, and then adds
+ * the conflicts to \c conflict_graph_ in the order they appear in the file.
+ *
+ * \param[in] tokens  The tokenized conflict graph
+ */
+void Algorithm::ResolveConflictGraph(const ConflictGraphTokens &tokens) {
+    std::vector<std::vector<std::pair<size_t, size_t>>> file_ids(tokens.blocks.size());
+
+    auto find = [this, &tokens](std::string_view name, const ConflictToken &token) {
+        auto id = file_names_.Find(name);
+        if (id == NameTable::kNotFound) {
+            LOG(FATAL) << tokens.path << ":" << token.line_number << ": unknown file \"" << name << "\"";
+        }
+        return id;
+    };
+
+    ParallelFor(tokens.blocks.size(), tokens.blocks.size(), [&](size_t, size_t begin, size_t end) {
+        for (auto block = begin; block < end; ++block) {
+            file_ids[block].reserve(tokens.blocks[block].size());
+            for (const auto &token: tokens.blocks[block]) {
+                file_ids[block].emplace_back(find(token.first_file, token), find(token.second_file, token));
+            }
+        }
+    });
+
     conflict_graph_->Redefine(GetFilesSize());
 
     // Reading conflict graph information
-    while (getline(in_conflict_graph, line)) {
-        DLOG(INFO) << "Conflict: " << line;
-
-        std::vector<std::string> strs;
-        boost::split(strs, line, boost::is_any_of(" "));
-        auto first_file = strs[0];
-        auto second_file = strs[1];
-        auto conflict_value = stod(strs[2]);
-        auto first_file_id = file_map_per_name.find(first_file)->second->get_id();
-        auto second_file_id = file_map_per_name.find(second_file)->second->get_id();
-        conflict_graph_->AddConflict(first_file_id, second_file_id, static_cast<int>(conflict_value));
+    for (size_t block = 0ul; block < tokens.blocks.size(); ++block) {
+        for (size_t i = 0ul; i < tokens.blocks[block].size(); ++i) {
+            conflict_graph_->AddConflict(file_ids[block][i].first, file_ids[block][i].second,
+                                         tokens.blocks[block][i].value);
+        }
     }
+    conflict_graph_->Build();
 
     DLOG(INFO) << "Finished reading Conflict Graph" ;
-
-    in_conflict_graph.close();
 }
 
 /**
  * The the three input files.
  *
+ * The cluster and the tokenization of the conflict graph do not depend on the activations and
+ * files, so they run on their own threads while the tasks and files are read. The conflict
+ * graph is resolved once the file names are known.
+ *
  * \param[in] tasks_and_files_file  Name of the Activation and Files input file
  * \param[in] cluster_file          Name of the Cluster input file
  * \param[in] conflict_graph_file   Name of the Conflict Graph input file
@@ -424,11 +546,83 @@ void Algorithm::ReadConflictGraph(const std::string &conflict_graph,
 void Algorithm::ReadInputFiles(const std::string &tasks_and_files_file,
                                const std::string &cluster_file,
                                const std::string &conflict_graph_file) {
-    std::unordered_map<std::string, std::shared_ptr<File>> file_map_per_name;
+    ConflictGraphTokens conflict_graph_tokens;
+
+    std::thread cluster_reader([this, &cluster_file] { ReadCluster(cluster_file); });
+    std::thread conflict_graph_tokenizer([&conflict_graph_file, &conflict_graph_tokens] {
+        TokenizeConflictGraph(conflict_graph_file, conflict_graph_tokens);
+    });
+
+    ReadTasksAndFiles(tasks_and_files_file);
+    conflict_graph_tokenizer.join();
+    ResolveConflictGraph(conflict_graph_tokens);
+    cluster_reader.join();
+    PrepareInstance();
+}
+
+/**
+ * Reads the tasks and files and the cluster input files concurrently. The conflict graph is left
+ * without conflicts, to be generated by \c GenerateConflictGraph.
+ *
+ * \param[in] tasks_and_files_file  Name of the Activation and Files input file
+ * \param[in] cluster_file          Name of the Cluster input file
+ */
+void Algorithm::ReadInputFiles(const std::string &tasks_and_files_file, const std::string &cluster_file) {
+    std::thread cluster_reader([this, &cluster_file] { ReadCluster(cluster_file); });
+
+    ReadTasksAndFiles(tasks_and_files_file);
+    conflict_graph_->Redefine(GetFilesSize());
+    cluster_reader.join();
+    PrepareInstance();
+}
+
+/**
+ * Replaces the conflict graph with a random one over the loaded files (see \c SampleConflicts).
+ *
+ * \param[in] density             Probability of a conflict between two files
+ * \param[in] hard_ratio          Probability of a conflict being a hard constraint
+ * \param[in] maximum_soft_value  Largest value of a soft constraint
+ * \param[in] seed                Seed of the random numbers
+ * \param[in] output_file         The graph is also written in this .scg file, unless it is empty
+ */
+void Algorithm::GenerateConflictGraph(double density,
+                                      double hard_ratio,
+                                      int maximum_soft_value,
+                                      uint64_t seed,
+                                      const std::string &output_file) {
+    auto blocks = SampleConflicts(GetFilesSize(), density, hard_ratio, maximum_soft_value, seed);
+
+    conflict_graph_ = std::make_shared<ConflictGraph>();
+    conflict_graph_->Redefine(GetFilesSize());
+    size_t conflict_size = 0ul;
+    for (const auto &block: blocks) {
+        for (const auto &conflict: block) {
+            conflict_graph_->AddConflict(conflict.first_file, conflict.second_file,
+                                         static_cast<int>(conflict.value));
+        }
+        conflict_size += block.size();
+    }
+    conflict_graph_->Build();
+
+    DLOG(INFO) << "Generated " << conflict_size << " conflicts";
+
+    if (!output_file.empty()) {
+        WriteConflictGraph(output_file, blocks, [this](size_t id) { return file_names_.get_name(id); });
+    }
+}
+
+/**
+ * Fills the flat instance store, the link bandwidths, the storage capacities and the activation
+ * heights from the loaded instance, no matter whether it came from the text files or from an
+ * image.
+ */
+void Algorithm::PrepareInstance() {
+    instance_store_.Build(activations_, files_, successors_, requirements_.size());
+    // The store keeps the successors from now on
+    std::vector<std::vector<size_t>>().swap(successors_);
+
+    transfer_time_model_.Redefine(storages_);
 
-    ReadTasksAndFiles(tasks_and_files_file, file_map_per_name);
-    ReadCluster(cluster_file);
-    ReadConflictGraph(conflict_graph_file, file_map_per_name);
     storage_vet_.resize(storages_.size(), 0.0);
 
     for (const std::shared_ptr<Storage> &storage: storages_) {
@@ -436,16 +630,421 @@ void Algorithm::ReadInputFiles(const std::string &tasks_and_files_file,
         storage_vet_[storage->get_id()] = storage->get_storage();
     }
 
-    height_.resize(GetActivationSize(), -1);
-    ComputeHeight(id_source_, 0);
+    ComputeHeights();
+
+    max_output_files_ = 0ul;
+    for (size_t i = 0ul; i < activations_.size(); ++i) {
+        max_output_files_ = std::max(max_output_files_, instance_store_.GetOutputFiles(i).size());
+    }
+
+    CheckIndexLimits();
+    ComputeActivationTables();
 
 #ifndef NDEBUG
     for (size_t i = 0; i < height_.size(); ++i) {
         DLOG(INFO) << "Height[" << i << "]: " << height_[i];
     }
 #endif
+}
+
+namespace {
+
+/// Whether \c count elements of \c element_size bytes starting at \c offset fit in the image
+bool SectionFits(const instance_image::Header &header,
+                 instance_image::Section section,
+                 uint64_t count,
+                 uint64_t element_size) {
+    auto offset = header.sections[section];
+
+    if (offset % 8ul != 0ul || offset > header.image_size) {
+        return false;
+    }
+    return element_size == 0ul || count <= (header.image_size - offset) / element_size;
+}
+
+/// Return the first record of \c section
+template<typename T>
+const T *SectionData(const char *image, const instance_image::Header &header,
+                     instance_image::Section section) {
+    return reinterpret_cast<const T *>(image + header.sections[section]);
+}
+
+/// Append \c count records to \c image, starting \c section at the next 8-byte boundary
+template<typename T>
+void AppendSection(std::vector<char> &image, instance_image::Header &header,
+                   instance_image::Section section, const T *data, size_t count) {
+    image.resize((image.size() + 7ul) & ~size_t{7ul}, '\0');
+    header.sections[section] = image.size();
+    auto bytes = reinterpret_cast<const char *>(data);
+    image.insert(image.end(), bytes, bytes + count * sizeof(T));
+}
+
+}  // namespace
+
+/**
+ * Writes the loaded instance into a single binary image that \c ReadInstanceImage maps back
+ * without parsing. The image is written beside its final name and renamed afterwards, so
+ * concurrent runs never map a partially written image.
+ *
+ * \param[in] instance_image_file  Name of the image file to be written
+ */
+void Algorithm::WriteInstanceImage(const std::string &instance_image_file) {
+    using namespace instance_image;
+    DLOG(INFO) << "Writing instance image [" + instance_image_file + "]";
+
+    Header header{};
+    std::vector<char> names;
+    auto add_name = [&names](std::string_view name, uint64_t &offset, uint64_t &length) {
+        offset = names.size();
+        length = name.size();
+        names.insert(names.end(), name.begin(), name.end());
+    };
+
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order_mark = kByteOrderMark;
+    header.static_file_size = static_file_size_;
+    header.dynamic_file_size = dynamic_file_size_;
+    header.activation_size = activations_.size();
+    header.requirement_size = requirements_.size();
+    header.virtual_machine_size = virtual_machines_.size();
+    header.bucket_size = bucket_size_;
+    header.maximum_of_soft_constraints = conflict_graph_->get_maximum_of_soft_constraints();
+    header.makespan_max = makespan_max_;
+    header.budget_max = budget_max_;
+
+    std::vector<RequirementRecord> requirements;
+    for (const auto &requirement: requirements_) {
+        requirements.push_back({requirement.get_id(), static_cast<double>(requirement.get_max_value())});
+    }
+
+    std::vector<FileRecord> files(files_.size());
+    std::vector<uint64_t> static_file_vms;
+    for (size_t i = 0ul; i < files_.size(); ++i) {
+        files[i].size_in_MB = files_[i]->get_size_in_MB();
+        add_name(files_[i]->get_name(), files[i].name_offset, files[i].name_length);
+        files[i].vm_begin = static_file_vms.size();
+        if (auto static_file = std::dynamic_pointer_cast<StaticFile>(files_[i])) {
+            static_file_vms.insert(static_file_vms.end(), static_file->get_vms().begin(),
+                                   static_file->get_vms().end());
+        }
+        files[i].vm_end = static_file_vms.size();
+    }
+
+    std::vector<ActivationRecord> activations(activations_.size());
+    std::vector<uint64_t> activation_files;
+    std::vector<int32_t> activation_requirements;
+    std::vector<uint64_t> successor_offsets;
+    std::vector<uint64_t> successors;
+    for (size_t i = 0ul; i < activations_.size(); ++i) {
+        const auto &activation = activations_[i];
+        auto &record = activations[i];
+
+        record.time = activation->get_time();
+        add_name(activation->get_tag(), record.tag_offset, record.tag_length);
+        add_name(activation->get_name(), record.name_offset, record.name_length);
+        record.input_begin = activation_files.size();
+        for (const auto &file: activation->get_input_files()) {
+            activation_files.push_back(file->get_id());
+        }
+        record.output_begin = activation_files.size();
+        for (const auto &file: activation->get_output_files()) {
+            activation_files.push_back(file->get_id());
+        }
+        record.output_end = activation_files.size();
+
+        for (auto requirement: activation->get_requirements()) {
+            activation_requirements.push_back(requirement);
+        }
+        successor_offsets.push_back(successors.size());
+        auto activation_successors = instance_store_.GetSuccessors(i);
+        successors.insert(successors.end(),
+                          activation_successors.begin(),
+                          activation_successors.end());
+    }
+    successor_offsets.push_back(successors.size());
+
+    std::vector<StorageRecord> storages(storages_.size());
+    std::vector<int32_t> storage_requirements;
+    for (size_t i = 0ul; i < storages_.size(); ++i) {
+        auto &record = storages[i];
+
+        record.type_id = storages_[i]->get_type_id();
+        record.storage = storages_[i]->get_storage();
+        record.bandwidth = storages_[i]->get_bandwidth();
+        add_name(storages_[i]->get_name(), record.name_offset, record.name_length);
+        if (auto vm = std::dynamic_pointer_cast<VirtualMachine>(storages_[i])) {
+            record.slowdown = vm->get_slowdown();
+            record.cost = vm->get_cost_per_hour();
+        } else {
+            auto bucket = std::dynamic_pointer_cast<Bucket>(storages_[i]);
+            record.is_bucket = 1ul;
+            record.cost = bucket->get_cost();
+            record.number_of_intervals = bucket->get_number_of_GB_per_cost_intervals();
+        }
+        for (size_t r = 0ul; r < requirements_.size(); ++r) {
+            storage_requirements.push_back(storages_[i]->GetRequirementValue(r));
+        }
+    }
 
-    ComputeFileTransferMatrix();
+    // The graph is symmetric, so the upper triangle holds every conflict
+    std::vector<ConflictRecord> conflicts;
+    std::vector<std::pair<size_t, int>> row;
+    for (size_t i = 0ul; i < files_.size(); ++i) {
+        row.clear();
+        conflict_graph_->ForEachConflict(i, [i, &row](size_t j, int value) {
+            if (j >= i) {
+                row.emplace_back(j, value);
+            }
+        });
+        std::sort(row.begin(), row.end());
+        for (const auto &[j, value]: row) {
+            conflicts.push_back({i, j, value == -1 ? 0 : value});
+        }
+    }
+
+    header.static_file_vm_size = static_file_vms.size();
+    header.activation_file_size = activation_files.size();
+    header.successor_size = successors.size();
+    header.conflict_size = conflicts.size();
+    header.name_size = names.size();
+
+    std::vector<char> image(sizeof(Header), '\0');
+    AppendSection(image, header, kRequirements, requirements.data(), requirements.size());
+    AppendSection(image, header, kFiles, files.data(), files.size());
+    AppendSection(image, header, kStaticFileVms, static_file_vms.data(), static_file_vms.size());
+    AppendSection(image, header, kActivations, activations.data(), activations.size());
+    AppendSection(image, header, kActivationFiles, activation_files.data(), activation_files.size());
+    AppendSection(image, header, kActivationRequirements, activation_requirements.data(),
+                  activation_requirements.size());
+    AppendSection(image, header, kSuccessorOffsets, successor_offsets.data(), successor_offsets.size());
+    AppendSection(image, header, kSuccessors, successors.data(), successors.size());
+    AppendSection(image, header, kStorages, storages.data(), storages.size());
+    AppendSection(image, header, kStorageRequirements, storage_requirements.data(),
+                  storage_requirements.size());
+    AppendSection(image, header, kConflicts, conflicts.data(), conflicts.size());
+    AppendSection(image, header, kNames, names.data(), names.size());
+    header.image_size = image.size();
+    std::memcpy(image.data(), &header, sizeof(Header));
+
+    auto temporary_file = instance_image_file + ".tmp";
+    std::ofstream out(temporary_file, std::ios::binary | std::ios::trunc);
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    out.close();
+
+    if (!out) {
+        LOG(FATAL) << "Instance image could not be written in \"" << temporary_file << "\"!";
+    }
+    std::filesystem::rename(temporary_file, instance_image_file);
+}
+
+/**
+ * Loads the instance from a binary image written by \c WriteInstanceImage. The image is mapped
+ * into memory and its records are copied straight into the \c Algorithm members.
+ *
+ * \param[in] instance_image_file  Name of the image file
+ * \retval    loaded               False if the image is missing or was written by another version,
+ *                                 in which case nothing was loaded
+ */
+bool Algorithm::ReadInstanceImage(const std::string &instance_image_file) {
+    using namespace instance_image;
+    DLOG(INFO) << "Reading instance image [" + instance_image_file + "]";
+
+    MappedFile mapped_file(instance_image_file);
+
+    if (!mapped_file.is_open() || mapped_file.size() < sizeof(Header)) {
+        LOG(WARNING) << "Instance image \"" << instance_image_file << "\" could not be read";
+        return false;
+    }
+
+    const char *image = mapped_file.data();
+    Header header{};
+    std::memcpy(&header, image, sizeof(Header));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+        || header.version != kVersion
+        || header.byte_order_mark != kByteOrderMark) {
+        LOG(WARNING) << "Instance image \"" << instance_image_file << "\" has an unknown format";
+        return false;
+    }
+
+    auto file_size = header.static_file_size + header.dynamic_file_size;
+    auto activation_size = header.activation_size;
+    auto requirement_size = header.requirement_size;
+    auto storage_size = header.virtual_machine_size + header.bucket_size;
+
+    if (header.image_size != mapped_file.size()
+        || activation_size < 2ul
+        || requirement_size > header.image_size
+        || !SectionFits(header, kRequirements, requirement_size, sizeof(RequirementRecord))
+        || !SectionFits(header, kFiles, file_size, sizeof(FileRecord))
+        || !SectionFits(header, kStaticFileVms, header.static_file_vm_size, sizeof(uint64_t))
+        || !SectionFits(header, kActivations, activation_size, sizeof(ActivationRecord))
+        || !SectionFits(header, kActivationFiles, header.activation_file_size, sizeof(uint64_t))
+        || !SectionFits(header, kActivationRequirements, activation_size,
+                        requirement_size * sizeof(int32_t))
+        || !SectionFits(header, kSuccessorOffsets, activation_size + 1ul, sizeof(uint64_t))
+        || !SectionFits(header, kSuccessors, header.successor_size, sizeof(uint64_t))
+        || !SectionFits(header, kStorages, storage_size, sizeof(StorageRecord))
+        || !SectionFits(header, kStorageRequirements, storage_size, requirement_size * sizeof(int32_t))
+        || !SectionFits(header, kConflicts, header.conflict_size, sizeof(ConflictRecord))
+        || !SectionFits(header, kNames, header.name_size, 1ul)) {
+        LOG(WARNING) << "Instance image \"" << instance_image_file << "\" is truncated";
+        return false;
+    }
+
+    const auto *names = SectionData<char>(image, header, kNames);
+    auto name = [&](uint64_t offset, uint64_t length) {
+        if (offset > header.name_size || length > header.name_size - offset) {
+            LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+        }
+        return std::string_view(names + offset, length);
+    };
+    auto intern = [&](NameTable &table, std::string_view interned_name, size_t id) {
+        if (table.Intern(interned_name) != id) {
+            LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+        }
+        return table.get_name(id);
+    };
+    auto check_id = [&](uint64_t id, uint64_t size) {
+        if (id >= size) {
+            LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+        }
+        return static_cast<size_t>(id);
+    };
+
+    static_file_size_ = header.static_file_size;
+    dynamic_file_size_ = header.dynamic_file_size;
+    makespan_max_ = header.makespan_max;
+    budget_max_ = header.budget_max;
+    id_source_ = 0ul;
+    id_target_ = activation_size - 1ul;
+
+    const auto *requirements = SectionData<RequirementRecord>(image, header, kRequirements);
+    requirements_.reserve(requirement_size);
+    for (size_t i = 0ul; i < requirement_size; ++i) {
+        requirements_.emplace_back(requirements[i].id, requirements[i].max_value);
+    }
+
+    const auto *files = SectionData<FileRecord>(image, header, kFiles);
+    const auto *static_file_vms = SectionData<uint64_t>(image, header, kStaticFileVms);
+    files_.reserve(file_size);
+    file_names_.Reserve(file_size);
+    for (size_t i = 0ul; i < file_size; ++i) {
+        const auto &record = files[i];
+        auto file_name = intern(file_names_, name(record.name_offset, record.name_length), i);
+
+        if (i < static_file_size_) {
+            auto static_file = std::make_shared<StaticFile>(i, file_name, record.size_in_MB);
+
+            if (record.vm_begin > record.vm_end || record.vm_end > header.static_file_vm_size) {
+                LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+            }
+            for (auto j = record.vm_begin; j < record.vm_end; ++j) {
+                static_file->AddVm(check_id(static_file_vms[j], header.virtual_machine_size));
+            }
+            files_.push_back(static_file);
+        } else {
+            files_.push_back(std::make_shared<DynamicFile>(i, file_name, record.size_in_MB));
+        }
+    }
+
+    const auto *activations = SectionData<ActivationRecord>(image, header, kActivations);
+    const auto *activation_files = SectionData<uint64_t>(image, header, kActivationFiles);
+    const auto *activation_requirements = SectionData<int32_t>(image, header, kActivationRequirements);
+    activations_.reserve(activation_size);
+    activation_tags_.Reserve(activation_size);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        const auto &record = activations[i];
+        auto activation_name = activation_names_.Intern(name(record.name_offset, record.name_length));
+        auto activation = std::make_shared<Activation>(i,
+                                                       intern(activation_tags_,
+                                                              name(record.tag_offset, record.tag_length), i),
+                                                       activation_names_.get_name(activation_name),
+                                                       record.time);
+
+        for (size_t r = 0ul; r < requirement_size; ++r) {
+            activation->AddRequirement(activation_requirements[i * requirement_size + r]);
+        }
+
+        if (record.input_begin > record.output_begin || record.output_begin > record.output_end
+            || record.output_end > header.activation_file_size) {
+            LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+        }
+        for (auto j = record.input_begin; j < record.output_begin; ++j) {
+            activation->AddInputFile(files_[check_id(activation_files[j], file_size)]);
+        }
+        for (auto j = record.output_begin; j < record.output_end; ++j) {
+            const auto &file = files_[check_id(activation_files[j], file_size)];
+            auto index = activation->AddOutputFile(file);
+
+            if (auto dynamic_file = std::dynamic_pointer_cast<DynamicFile>(file)) {
+                if (dynamic_file->get_parent_task().lock()) {
+                    LOG(FATAL) << file->get_name() << " already have a parent task!";
+                }
+                dynamic_file->set_parent_task(activation);
+                dynamic_file->set_parent_output_file_index(index);
+            }
+        }
+        activations_.push_back(activation);
+    }
+
+    const auto *successor_offsets = SectionData<uint64_t>(image, header, kSuccessorOffsets);
+    const auto *successors = SectionData<uint64_t>(image, header, kSuccessors);
+    successors_.resize(activation_size);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        if (successor_offsets[i] > successor_offsets[i + 1ul]
+            || successor_offsets[i + 1ul] > header.successor_size) {
+            LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+        }
+        successors_[i].reserve(successor_offsets[i + 1ul] - successor_offsets[i]);
+        for (auto j = successor_offsets[i]; j < successor_offsets[i + 1ul]; ++j) {
+            successors_[i].push_back(check_id(successors[j], activation_size));
+        }
+    }
+
+    const auto *storages = SectionData<StorageRecord>(image, header, kStorages);
+    const auto *storage_requirements = SectionData<int32_t>(image, header, kStorageRequirements);
+    storages_.reserve(storage_size);
+    virtual_machines_.reserve(header.virtual_machine_size);
+    for (size_t i = 0ul; i < storage_size; ++i) {
+        const auto &record = storages[i];
+        auto storage_name = std::string(name(record.name_offset, record.name_length));
+        std::shared_ptr<Storage> storage;
+
+        if (record.is_bucket != (i < header.virtual_machine_size ? 0ul : 1ul)) {
+            LOG(FATAL) << "Instance image \"" << instance_image_file << "\" is corrupted";
+        }
+        if (record.is_bucket) {
+            storage = std::make_shared<Bucket>(i, storage_name, record.storage, record.cost,
+                                               record.bandwidth, static_cast<int>(record.type_id),
+                                               record.number_of_intervals);
+        } else {
+            auto vm = std::make_shared<VirtualMachine>(i, storage_name, record.slowdown, record.storage,
+                                                       record.cost, record.bandwidth,
+                                                       static_cast<int>(record.type_id));
+            virtual_machines_.push_back(vm);
+            storage = vm;
+        }
+        for (size_t r = 0ul; r < requirement_size; ++r) {
+            storage->AddRequirement(storage_requirements[i * requirement_size + r]);
+        }
+        storages_.push_back(storage);
+    }
+    bucket_size_ = header.bucket_size;
+
+    const auto *conflicts = SectionData<ConflictRecord>(image, header, kConflicts);
+    conflict_graph_->Redefine(file_size);
+    for (size_t i = 0ul; i < header.conflict_size; ++i) {
+        conflict_graph_->AddConflict(check_id(conflicts[i].first_file, file_size),
+                                     check_id(conflicts[i].second_file, file_size),
+                                     static_cast<int>(conflicts[i].value));
+    }
+    conflict_graph_->Build();
+    conflict_graph_->set_maximum_of_soft_constraints(header.maximum_of_soft_constraints);
+
+    PrepareInstance();
+    return true;
 }
 
 /**
@@ -467,31 +1066,146 @@ std::shared_ptr<Algorithm> Algorithm::ReturnAlgorithm(const std::string &algorit
         return std::make_shared<Grasp>();
     } else if (algorithm == "heft") {
         return std::make_shared<Heft>();
+    } else if (algorithm == "compile") {
+        return std::make_shared<Compiler>();
+    } else if (algorithm == "parse_benchmark") {
+        return std::make_shared<ParseBenchmark>();
+    } else if (algorithm == "evaluation_benchmark") {
+        return std::make_shared<EvaluationBenchmark>();
     } else {
         std::fprintf(stderr, "Please select a valid algorithm.\n");
         std::exit(-1);
     }
 }
 
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "misc-no-recursion"
-void Algorithm::ComputeHeight(size_t node, int n) {
-    DLOG(INFO) << "Height " << n << " node " << node << " name " << activations_[node]->get_tag() << std::endl;
+/**
+ * The solutions keep the IDs and the times in \c IndexType and \c TimeType, 32 bits wide when built
+ * with \c WF_SECURITY_COMPACT_INDEX. No finish time can pass the time of running every activation,
+ * one after the other, on the slowest virtual machine, reading and writing each of its files
+ * through the slowest link; the largest value of the types is left for the missing ones.
+ */
+void Algorithm::CheckIndexLimits() const {
+    auto largest_index = static_cast<size_t>(kNoValue<IndexType>);
+    if (activations_.size() >= largest_index
+        || files_.size() >= largest_index
+        || storages_.size() >= largest_index) {
+        LOG(FATAL) << "The instance has more activations, files or storages than the solutions "
+                   << "can index; build without WF_SECURITY_COMPACT_INDEX";
+    }
 
-    if (height_[node] < n) {
-        height_[node] = n;
+    auto slowest_slowdown = 0.0;
+    for (const auto &vm: virtual_machines_) {
+        slowest_slowdown = std::max(slowest_slowdown, vm->get_slowdown());
+    }
+    auto slowest_bandwidth = std::numeric_limits<double>::max();
+    for (const auto &storage: storages_) {
+        slowest_bandwidth = std::min(slowest_bandwidth, storage->get_bandwidth_in_GBps());
+    }
 
-        auto vet = successors_[node];
-        for (auto j: vet) {
-            ComputeHeight(j, n + 1);
+    // Every transfer takes at least one unit of time
+    auto longest_time = 0.0;
+    for (size_t i = 0ul; i < activations_.size(); ++i) {
+        longest_time += std::ceil(instance_store_.GetActivationTime(i) * slowest_slowdown);
+        for (auto file_id: instance_store_.GetInputFiles(i)) {
+            longest_time += std::max(1.0, std::ceil(instance_store_.GetFileSizeInGB(file_id)
+                                                    / slowest_bandwidth));
+        }
+        for (auto file_id: instance_store_.GetOutputFiles(i)) {
+            longest_time += std::max(1.0, std::ceil(instance_store_.GetFileSizeInGB(file_id)
+                                                    / slowest_bandwidth));
         }
     }
+    if (longest_time >= static_cast<double>(kNoValue<TimeType>)) {
+        LOG(FATAL) << "The times of the instance can reach " << longest_time
+                   << ", more than the solutions can keep; build without WF_SECURITY_COMPACT_INDEX";
+    }
 }
 
-void Algorithm::ComputeFileTransferMatrix() {
+/**
+ * The solvers read the run time and the requirement shortfall of an activation on a virtual
+ * machine from these tables instead of deriving them from the model objects at every evaluation.
+ * The requirement values are integers, so the sums are exact in any order.
+ */
+void Algorithm::ComputeActivationTables() {
+    auto vm_size = virtual_machines_.size();
+    activation_run_times_.assign(activations_.size() * vm_size, 0u);
+    activation_exposures_.assign(activations_.size() * vm_size, 0.0);
+
+    for (size_t i = 0ul; i < activations_.size(); ++i) {
+        const auto &activation = activations_[i];
+        for (size_t j = 0ul; j < vm_size; ++j) {
+            const auto &vm = virtual_machines_[j];
+            activation_run_times_[(i * vm_size) + j] = static_cast<TimeType>(
+                    std::ceil(instance_store_.GetActivationTime(i) * vm->get_slowdown()));
+
+            auto exposure = 0.0;
+            for (size_t r = 0ul; r < activation->get_requirements().size(); ++r) {
+                if (activation->GetRequirementValue(r) > vm->GetRequirementValue(r)) {
+                    exposure += activation->GetRequirementValue(r) - vm->GetRequirementValue(r);
+                }
+            }
+            activation_exposures_[(i * vm_size) + j] = exposure;
+        }
+    }
+}
+
+/**
+ * Kahn's algorithm: an activation is taken once all its predecessors were, and its height is then
+ * one more than the largest height among them. The levels bucket the activations by height with a
+ * counting sort. Everything is O(V + E).
+ */
+void Algorithm::ComputeHeights() {
+    auto activation_size = GetActivationSize();
+    std::vector<size_t> in_degree(activation_size, 0ul);
+
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        in_degree[i] = instance_store_.GetPredecessors(i).size();
+    }
+
+    height_.assign(activation_size, -1);
+    topological_order_.clear();
+    topological_order_.reserve(activation_size);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        if (in_degree[i] == 0ul) {
+            height_[i] = 0;
+            topological_order_.push_back(i);
+        }
+    }
+
+    // The order itself is the queue of activations ready to be taken
+    for (size_t next = 0ul; next < topological_order_.size(); ++next) {
+        auto activation = topological_order_[next];
+
+        for (auto successor: instance_store_.GetSuccessors(activation)) {
+            height_[successor] = std::max(height_[successor], height_[activation] + 1);
+            if (--in_degree[successor] == 0ul) {
+                topological_order_.push_back(successor);
+            }
+        }
+    }
+
+    if (topological_order_.size() != activation_size) {
+        auto in_cycle = std::find_if(in_degree.begin(), in_degree.end(),
+                                     [](size_t degree) { return degree != 0ul; });
+        LOG(FATAL) << "The workflow has a cycle through the activation "
+                   << activations_[static_cast<size_t>(in_cycle - in_degree.begin())]->get_tag();
+    }
+
+    auto level_size = activation_size == 0ul ? 0ul
+            : static_cast<size_t>(*std::max_element(height_.begin(), height_.end())) + 1ul;
+
+    level_offsets_.assign(level_size + 1ul, 0ul);
+    for (auto height: height_) {
+        ++level_offsets_[static_cast<size_t>(height) + 1ul];
+    }
+    for (size_t level = 0ul; level < level_size; ++level) {
+        level_offsets_[level + 1ul] += level_offsets_[level];
+    }
 
-    for (const auto& file : files_) {
-        file->PopulateFileTransferMatrix(storages_);
+    std::vector<size_t> next_position(level_offsets_.begin(), level_offsets_.end() - 1);
+    level_activations_.resize(activation_size);
+    for (size_t i = 0ul; i < activation_size; ++i) {
+        level_activations_[next_position[static_cast<size_t>(height_[i])]++] = i;
     }
 }
 
@@ -14,11 +14,16 @@
 #define APPROXIMATE_SOLUTIONS_SRC_SOLUTION_ALGORITHM_H_
 
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "src/common/index_types.h"
+#include "src/common/mapped_file.h"
+#include "src/common/name_table.h"
 #include "src/model/file.h"
 #include "src/model/requirement.h"
 #include "src/model/activation.h"
@@ -26,6 +31,8 @@
 #include "src/model/bucket.h"
 #include "src/model/solution.h"
 #include "src/model/conflict_graph.h"
+#include "src/model/instance_store.h"
+#include "src/model/transfer_time_model.h"
 
 class Solution;
 
@@ -47,6 +54,22 @@ public:
                         const std::string &cluster_file,
                         const std::string &conflict_graph_file);
 
+    /// Read the tasks and files and the cluster input files, leaving the conflict graph empty
+    void ReadInputFiles(const std::string &tasks_and_files_file, const std::string &cluster_file);
+
+    /// Replace the conflict graph with a random one over the loaded files
+    void GenerateConflictGraph(double density,
+                               double hard_ratio,
+                               int maximum_soft_value,
+                               uint64_t seed,
+                               const std::string &output_file);
+
+    /// Load the instance from a binary image written by \c WriteInstanceImage
+    bool ReadInstanceImage(const std::string &instance_image_file);
+
+    /// Write the loaded instance as a binary image
+    void WriteInstanceImage(const std::string &instance_image_file);
+
     /// Getter for \c id_source_
     size_t get_id_source() const { return id_source_; }
 
@@ -54,17 +77,29 @@ public:
     size_t get_id_target() const { return id_target_; }
 
     /// Getter for \c conflict_graph_
-    std::shared_ptr<ConflictGraph> get_conflict_graph() { return conflict_graph_; }
+    const std::shared_ptr<ConflictGraph> &get_conflict_graph() const { return conflict_graph_; }
 
     /// Getter for \c storage_vet_
     std::vector<double> &get_storage_vet() { return storage_vet_; }
 
     /// Getter for \c height_
-    std::vector<int> &get_height() { return height_; }
+    const std::vector<int> &get_height() const { return height_; }
+
+    /// Getter for \c topological_order_
+    const std::vector<size_t> &get_topological_order() const { return topological_order_; }
+
+    /// Getter for \c level_activations_
+    const std::vector<size_t> &get_level_activations() const { return level_activations_; }
+
+    /// Getter for \c level_offsets_
+    const std::vector<size_t> &get_level_offsets() const { return level_offsets_; }
 
     /// Getter for \c bucket_size_
     size_t get_bucket_size() const { return bucket_size_; }
 
+    /// Getter for \c max_output_files_
+    size_t get_max_output_files() const { return max_output_files_; }
+
     /// Return the size of the \c activations_
     size_t GetActivationSize() const { return activations_.size(); }
 
@@ -81,22 +116,65 @@ public:
     size_t GetRequirementsSize() const { return requirements_.size(); }
 
     /// Return a pointer to the \c File identified by \c id
-    std::shared_ptr<File> GetFilePerId(size_t id) { return files_[id]; }
+    const std::shared_ptr<File> &GetFilePerId(size_t id) const { return files_[id]; }
 
     /// Return a pointer to the \c Activation identified by \c id
-    std::shared_ptr<Activation> GetActivationPerId(size_t id) { return activations_[id]; }
+    const std::shared_ptr<Activation> &GetActivationPerId(size_t id) const { return activations_[id]; }
 
     /// Return a pointer to the \c Storage identified by \c id
-    std::shared_ptr<Storage> GetStoragePerId(size_t id) { return storages_[id]; }
+    const std::shared_ptr<Storage> &GetStoragePerId(size_t id) const { return storages_[id]; }
 
     /// Return a pointer to the \c VirtualMachine identified by \c id
-    std::shared_ptr<VirtualMachine> GetVirtualMachinePerId(size_t id) { return virtual_machines_[id]; }
+    const std::shared_ptr<VirtualMachine> &GetVirtualMachinePerId(size_t id) const {
+        return virtual_machines_[id];
+    }
+
+    /// Return the time to move the file \c file_id from the storage \c origin_id to \c target_id
+    [[nodiscard]] size_t GetFileTransfer(size_t file_id, size_t origin_id, size_t target_id) const {
+        return transfer_time_model_.GetFileTransfer(instance_store_.GetFileSizeInGB(file_id),
+                                                    origin_id,
+                                                    target_id);
+    }
+
+    /// Time to run the \c Activation \c activation_id on the \c VirtualMachine \c vm_id
+    [[nodiscard]] size_t GetActivationRunTime(size_t activation_id, size_t vm_id) const {
+        return activation_run_times_[(activation_id * virtual_machines_.size()) + vm_id];
+    }
+
+    /// Sum of the requirements of the \c Activation \c activation_id the \c VirtualMachine
+    /// \c vm_id falls short of
+    [[nodiscard]] double GetActivationExposure(size_t activation_id, size_t vm_id) const {
+        return activation_exposures_[(activation_id * virtual_machines_.size()) + vm_id];
+    }
+
+    /// Whether the \c File identified by \c file_id is static, placed by the instance
+    [[nodiscard]] bool IsStaticFile(size_t file_id) const {
+        return instance_store_.IsStaticFile(file_id);
+    }
+
+    /// Return the storage holding the static \c File identified by \c file_id
+    [[nodiscard]] size_t GetStaticFileStorage(size_t file_id) const {
+        return instance_store_.GetStaticFileStorage(file_id);
+    }
+
+    /// Whether the storage identified by \c storage_id is a virtual machine; the buckets follow
+    /// the virtual machines in \c storages_
+    [[nodiscard]] bool IsVirtualMachine(size_t storage_id) const {
+        return storage_id < virtual_machines_.size();
+    }
+
+    /// Return the successors of the \c Activation identified by \c activation_id
+    IdRange GetSuccessors(size_t activation_id) const {
+        return instance_store_.GetSuccessors(activation_id);
+    }
 
-    /// Return a reference to the successors of the \c Activation identified by \c activation_id
-    std::vector<size_t> &GetSuccessors(size_t activation_id) { return successors_[activation_id]; }
+    /// Return the predecessors of the \c Activation identified by \c activation_id
+    IdRange GetPredecessors(size_t activation_id) const {
+        return instance_store_.GetPredecessors(activation_id);
+    }
 
-    /// Return a reference to the predecessors of the \c Activation identified by \c activation_id
-    std::vector<size_t> &GetPredecessors(size_t activation_id) { return predecessors_[activation_id]; }
+    /// Getter for \c instance_store_
+    const InstanceStore &get_instance_store() const { return instance_store_; }
 
     /// Getter for makespan_max_
     double get_makespan_max() const { return makespan_max_; }
@@ -150,21 +228,47 @@ public:
 
 protected:
     ///
-    void ReadTasksAndFiles(const std::string &tasks_and_files_file,
-                           std::unordered_map<std::string, std::shared_ptr<File>> &file_map_per_name);
+    void ReadTasksAndFiles(const std::string &tasks_and_files_file);
 
     ///
     void ReadCluster(const std::string &);
 
     ///
-    void ReadConflictGraph(const std::string &conflict_graph,
-                           std::unordered_map<std::string, std::shared_ptr<File>> &file_map_per_name);
+    void ReadConflictGraph(const std::string &conflict_graph);
 
-    ///
-    void ComputeHeight(size_t, int);
+    /// A line of the conflict graph before its file names are resolved
+    struct ConflictToken {
+        std::string_view first_file;
+        std::string_view second_file;
+        int value;
+        size_t line_number;
+    };
+
+    /// The conflict graph file mapped or decompressed in memory, tokenized in blocks of lines
+    struct ConflictGraphTokens {
+        std::string path;
+        std::unique_ptr<MappedFile> file;
+        std::vector<char> buffer;
+        std::vector<std::vector<ConflictToken>> blocks;
+    };
+
+    /// Tokenize the conflict graph in parallel; it does not depend on the other input files
+    static void TokenizeConflictGraph(const std::string &conflict_graph, ConflictGraphTokens &tokens);
+
+    /// Resolve the tokenized file names and fill \c conflict_graph_ in the order of the file
+    void ResolveConflictGraph(const ConflictGraphTokens &tokens);
 
-	///
-    void ComputeFileTransferMatrix();
+    /// Compute the data derived from the loaded instance
+    void PrepareInstance();
+
+    /// Compute the heights, the topological order and the levels of the activations
+    void ComputeHeights();
+
+    /// Fail when the instance does not fit in the \c IndexType and \c TimeType of the solutions
+    void CheckIndexLimits() const;
+
+    /// Fill the tables of every activation on every virtual machine
+    void ComputeActivationTables();
 
     ///
     size_t static_file_size_{};
@@ -193,27 +297,59 @@ protected:
     ///
     std::vector<std::shared_ptr<File>> files_;
 
+    /// The file names; the ID of a name is the ID of its file
+    NameTable file_names_;
+
+    /// The activation tags; the ID of a tag is the ID of its activation
+    NameTable activation_tags_;
+
+    /// The distinct activation names, shared by the activations running the same program
+    NameTable activation_names_;
+
     ///
     std::vector<std::shared_ptr<Activation>> activations_;
 
     ///
     std::vector<std::shared_ptr<Storage>> storages_;
 
+    /// The transfer times of the files between the \c storages_
+    TransferTimeModel transfer_time_model_;
+
     ///
     std::vector<std::shared_ptr<VirtualMachine>> virtual_machines_;
 
-    ///
+    /// The successors of every activation while the instance is loaded
     std::vector<std::vector<size_t>> successors_;
 
-    ///
-    std::vector<std::vector<size_t>> predecessors_;
+    /// The flat copy of the instance, built once it is loaded
+    InstanceStore instance_store_;
 
     /// Number of the buckets
     size_t bucket_size_ = 0ul;
 
-    ///
+    /// The most output files of an activation
+    size_t max_output_files_ = 0ul;
+
+    /// Run time of every activation on every virtual machine, a line of virtual machines per
+    /// activation
+    std::vector<TimeType> activation_run_times_;
+
+    /// Requirement shortfall of every activation on every virtual machine, laid out as
+    /// \c activation_run_times_
+    std::vector<double> activation_exposures_;
+
+    /// Length of the longest path from the source to every activation
     std::vector<int> height_;
 
+    /// The activations in an order where every activation comes after its predecessors
+    std::vector<size_t> topological_order_;
+
+    /// The activations sorted by height, those of the same height by ID
+    std::vector<size_t> level_activations_;
+
+    /// Activations of height h are [level_offsets_[h], level_offsets_[h + 1]) of \c level_activations_
+    std::vector<size_t> level_offsets_;
+
     ///
     std::shared_ptr<ConflictGraph> conflict_graph_;
 
@@ -0,0 +1,30 @@
+/**
+ * \file src/solution/compiler.cc
+ * \brief Contains the \c Compiler class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods for the \c Compiler class that writes the binary instance
+ * image
+ */
+
+#include "src/solution/compiler.h"
+
+DECLARE_string(instance_image);
+
+/**
+ * Writes the instance read from the text files into the image named by \c --instance_image, so
+ * later runs can load it with \c --instance_image instead of parsing the text files again.
+ */
+void Compiler::Run() {
+    if (FLAGS_instance_image.empty()) {
+        LOG(FATAL) << "The compile mode needs the output image in --instance_image";
+    }
+
+    WriteInstanceImage(FLAGS_instance_image);
+
+    std::cout << "Instance image written in " << FLAGS_instance_image << std::endl;
+}
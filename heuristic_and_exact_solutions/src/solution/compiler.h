@@ -0,0 +1,40 @@
+/**
+ * \file src/solution/compiler.h
+ * \brief Contains the \c Compiler class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c Compiler class that turns the text input files into a binary
+ * instance image.
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_SOLUTION_COMPILER_H_
+#define APPROXIMATE_SOLUTIONS_SRC_SOLUTION_COMPILER_H_
+
+
+#include <string>
+
+#include "src/solution/algorithm.h"
+
+class Compiler : public Algorithm {
+public:
+    ///
+    Compiler() = default;
+
+    ///
+    virtual ~Compiler() = default;
+
+    ///
+    [[nodiscard]] std::string GetName() const override { return name_; }
+
+    /// Write the loaded instance into the image named by \c --instance_image
+    void Run() override;
+private:
+    std::string name_ = "compile";
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_SOLUTION_COMPILER_H_
@@ -0,0 +1,116 @@
+/**
+ * \file src/solution/evaluation_benchmark.cc
+ * \brief Contains the \c EvaluationBenchmark class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods for the \c EvaluationBenchmark class that measures the
+ * evaluation of the objective function
+ */
+
+#include "src/solution/evaluation_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#include "src/common/allocation_counter.h"
+
+DECLARE_uint64(number_of_iteration);
+DECLARE_string(local_search_evaluation);
+
+/**
+ * Builds one schedule level by level, as an iteration of the GRCH does, and then evaluates it again
+ * and again with \c OptimizedComputeObjectiveFunction(). The construction is timed once and then
+ * done again after \c Solution::Reset(), as the next iteration of the GRCH would, counting its heap
+ * allocations; the evaluations are measured by their rate and the heap allocations each of them
+ * makes, and any of them stops the benchmark. The allocations are only counted when built with
+ * \c WF_SECURITY_COUNT_ALLOCATIONS. At last, the local searches of the GRASP run
+ * \c --number_of_iteration rounds on copies of the schedule, once evaluating every move from the
+ * start of the ordering, once from the first position the move changes, and once timing again only
+ * the activations the move can delay and taking the cost and exposure changes as deltas; their
+ * moves are measured by their rate.
+ */
+void EvaluationBenchmark::Run() {
+    using Clock = std::chrono::steady_clock;
+    auto iterations = std::max<uint64_t>(FLAGS_number_of_iteration, 1ul);
+    Solution solution(shared_from_this());
+    std::vector<std::shared_ptr<Activation>> avail_activations;
+
+    auto build = [&]() {
+        for (size_t level = 0ul; level + 1ul < level_offsets_.size(); ++level) {
+            avail_activations.clear();
+            for (auto j = level_offsets_[level]; j < level_offsets_[level + 1ul]; ++j) {
+                avail_activations.push_back(activations_[level_activations_[j]]);
+            }
+            ScheduleAvailTasks(avail_activations, solution);
+        }
+    };
+
+    auto construction_start = Clock::now();
+    build();
+    auto construction_seconds =
+            std::chrono::duration<double>(Clock::now() - construction_start).count();
+
+    auto construction_allocations = AllocationCount();
+    solution.Reset();
+    build();
+    construction_allocations = AllocationCount() - construction_allocations;
+
+    auto objective_value = 0.0;
+    auto allocations = AllocationCount();
+    auto start = Clock::now();
+    for (uint64_t i = 0ul; i < iterations; ++i) {
+        objective_value = solution.OptimizedComputeObjectiveFunction();
+    }
+    auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    allocations = AllocationCount() - allocations;
+
+    // Once the buffers have grown, neither an iteration of the GRCH nor an evaluation allocates
+    if (kCountAllocations && (construction_allocations != 0ul || allocations != 0ul)) {
+        LOG(FATAL) << "The construction after a reset made " << construction_allocations
+                   << " heap allocations and the evaluations " << allocations << "; none expected";
+    }
+
+    std::cout << std::fixed << std::setprecision(6)
+              << "Construction seconds: " << construction_seconds << "\n"
+              << "Objective value: " << objective_value << "\n"
+              << "Evaluations per second: " << static_cast<double>(iterations) / seconds
+              << std::endl;
+    if (kCountAllocations) {
+        std::cout << "Allocations per construction after a reset: " << construction_allocations
+                  << "\n"
+                  << "Allocations per evaluation: "
+                  << static_cast<double>(allocations) / static_cast<double>(iterations)
+                  << std::endl;
+    } else {
+        std::cout << "Allocations: not counted; build with WF_SECURITY_COUNT_ALLOCATIONS"
+                  << std::endl;
+    }
+
+    auto local_search_evaluation = FLAGS_local_search_evaluation;
+    for (const auto *evaluation: {"full", "suffix", "cone"}) {
+        FLAGS_local_search_evaluation = evaluation;
+        Solution searched_solution = solution;
+        searched_solution.OptimizedComputeObjectiveFunction();
+
+        auto search_start = Clock::now();
+        for (uint64_t i = 0ul; i < iterations; ++i) {
+            if (!searched_solution.localSearchN3() && !searched_solution.localSearchN1()
+                && !searched_solution.localSearchN2()) {
+                break;
+            }
+        }
+        auto search_seconds = std::chrono::duration<double>(Clock::now() - search_start).count();
+
+        std::cout << "Local search objective value (" << evaluation << "): "
+                  << searched_solution.get_objective_value() << "\n"
+                  << "Local search moves per second (" << evaluation << "): "
+                  << static_cast<double>(searched_solution.get_number_of_moves()) / search_seconds
+                  << std::endl;
+    }
+    FLAGS_local_search_evaluation = local_search_evaluation;
+}
@@ -0,0 +1,42 @@
+/**
+ * \file src/solution/evaluation_benchmark.h
+ * \brief Contains the \c EvaluationBenchmark class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c EvaluationBenchmark class that measures the evaluation of the
+ * objective function.
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_SOLUTION_EVALUATION_BENCHMARK_H_
+#define APPROXIMATE_SOLUTIONS_SRC_SOLUTION_EVALUATION_BENCHMARK_H_
+
+
+#include <string>
+
+#include "src/solution/grch.h"
+
+class EvaluationBenchmark : public Grch {
+public:
+    ///
+    EvaluationBenchmark() = default;
+
+    ///
+    virtual ~EvaluationBenchmark() = default;
+
+    ///
+    [[nodiscard]] std::string GetName() const override { return name_; }
+
+    /// Time the construction of a schedule and count the allocations of building it again, then
+    /// evaluate it \c --number_of_iteration times and print the rate and allocations, and the rate
+    /// of the local search moves with every evaluation of the moves
+    void Run() override;
+private:
+    std::string name_ = "evaluation_benchmark";
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_SOLUTION_EVALUATION_BENCHMARK_H_
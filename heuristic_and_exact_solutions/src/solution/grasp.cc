@@ -84,46 +84,30 @@ void Grasp::Run() {
     auto best_solution_iteration = 0ul;
     double best_solution_time;
     auto baseline = best_solution.get_objective_value();
+    std::vector<std::shared_ptr<Activation>> avail_activations;
+    Solution solution(shared_from_this());
 
     for (auto o = 0ul; o < std::numeric_limits<size_t>::max(); ++o) {
 
-        // 1. Construction phase (GreedyRandomizedAlgorithm)
-        std::vector<std::shared_ptr<Activation>> activation_list;
-        std::vector<std::shared_ptr<Activation>> avail_activations;
-        Solution solution(shared_from_this());
+        // 1. Construction phase (GreedyRandomizedAlgorithm), on the buffers of the previous
+        // iterations
+        solution.Reset();
 
-        // Start activation list
-        DLOG(INFO) << "Initialize activations list";
-        for (const auto &activations: activations_) {
-            activation_list.push_back(activations);
-        }
-
-        // Order by height
-        DLOG(INFO) << "Order by height";
-        std::sort(activation_list.begin(), activation_list.end(),
-                  [&](const std::shared_ptr<Activation> &a, const std::shared_ptr<Activation> &b) {
-                      return height_[a->get_id()] < height_[b->get_id()];
-                  });
-
-        // The activation_list is sorted by the height(t). While activation_list is not empty do
+        // The levels hold the activations by height(t), computed once when the instance is loaded
         DLOG(INFO) << "Doing scheduling";
-        while (!activation_list.empty()) {
-            auto task = activation_list.front();  // Get the first activation
-
+        for (size_t level = 0ul; level + 1ul < level_offsets_.size(); ++level) {
             avail_activations.clear();
-            while (!activation_list.empty()
-                   && height_[task->get_id()] == height_[activation_list.front()->get_id()]) {
+            for (auto j = level_offsets_[level]; j < level_offsets_[level + 1ul]; ++j) {
                 // Build list of ready tasks, that is the tasks which the predecessor was finish
-                DLOG(INFO) << "Putting " << activation_list.front()->get_id() << " in avail_activations";
-                avail_activations.push_back(activation_list.front());
-                activation_list.erase(activation_list.begin());
+                DLOG(INFO) << "Putting " << level_activations_[j] << " in avail_activations";
+                avail_activations.push_back(activations_[level_activations_[j]]);
             }
 
             DLOG(INFO) << "Shuffling activation list";
             std::shuffle(avail_activations.begin(), avail_activations.end(), generator());
 
             // Schedule the ready tasks (same height)
-            solution = ScheduleAvailTasks(avail_activations, solution);
+            ScheduleAvailTasks(avail_activations, solution);
         }
         DLOG(INFO) << "Scheduling done";
 
@@ -132,7 +116,7 @@ void Grasp::Run() {
 
         // Store the best solution
         if (best_solution.get_objective_value() > solution.get_objective_value()) {
-            best_solution = solution;
+            std::swap(best_solution, solution);
             time_s = ((double) clock() - (double) t_start) / CLOCKS_PER_SEC;    // Processing time
         }
 
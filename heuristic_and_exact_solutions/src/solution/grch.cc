@@ -22,21 +22,26 @@ DECLARE_uint64(number_of_iteration);
  * Use allocates the availed task into \c allocation_ and store the execution ordering into
  * \c ordering_.
  *
- * \param[in]  avail_activations     Avail tasks to be processed
+ * Every activation is tried at every VM on \c solution itself and rolled back right after; only
+ * the move of its best VM is kept, and the move of the selected candidate is redone.
+ *
+ * \param[in,out]  avail_activations     Avail tasks to be processed, removed as they are scheduled
  * \param[in]  solution        The solution to be built
  */
-Solution Grch::ScheduleAvailTasks(std::vector<std::shared_ptr<Activation>> avail_activations, Solution &solution) {
+void Grch::ScheduleAvailTasks(std::vector<std::shared_ptr<Activation>> &avail_activations, Solution &solution) {
     DLOG(INFO) << "Scheduling the availed activations to the solution ...";
-    Solution best_solution = solution;
 
     // As long as there are allocations to be allocated, do
     while (!avail_activations.empty()) {
-        std::list<std::pair<std::shared_ptr<Activation>, Solution>> avail_solutions;
+        if (candidates_.size() < avail_activations.size()) {
+            candidates_.resize(avail_activations.size());
+        }
+        candidate_order_.clear();
 
         // 1. Computing time
-        for (const auto &activation: avail_activations) {
-            // The solution with the best O.F. after choosing a specific VM
-            Solution best_temporary_solution(shared_from_this());
+        for (size_t c = 0ul; c < avail_activations.size(); ++c) {
+            const auto &activation = avail_activations[c];
+            auto &candidate = candidates_[c];
 
             // Begin with a BIG O.F.
             auto best_of = std::numeric_limits<double>::max();
@@ -44,58 +49,59 @@ Solution Grch::ScheduleAvailTasks(std::vector<std::shared_ptr<Activation>> avail
 
             // Compute the O.F. in each Vm
             for (auto &vm: virtual_machines_) {
-                auto new_solution = best_solution;
-                auto of = new_solution.ScheduleActivation(activation, vm);
+                solution.ScheduleActivation(activation, vm, trial_move_);
+                auto of = trial_move_.objectives.objective_value;
+                solution.Rollback(trial_move_);
 
-                // Select the best VM
+                // Select the best VM, keeping its move with the candidate
                 if ((of < best_of)
                     || (of == best_of
                         && vm->get_cost() < best_vm->get_cost())
                     || (of == best_of
                         && vm->get_cost() == best_vm->get_cost()
-                        && vm->get_slowdown() < best_vm->get_slowdown())) {
+                        && vm->get_slowdown() < best_vm->get_slowdown())
+                    || vm == virtual_machines_[0ul]) {
                     best_of = of;
                     best_vm = vm;
-                    best_temporary_solution = new_solution;
+                    std::swap(candidate.move, trial_move_);
                 }
             }
 
-            // Put the best current solution in the list
-            avail_solutions.emplace_back(activation, best_temporary_solution);
+            // Put the best current move in the list
+            candidate.activation = activation;
+            candidate.objective_value = best_of;
+            candidate_order_.push_back(c);
         }
 
-        if (!avail_solutions.empty()) {
-            // Sorting elements
-            avail_solutions.sort([&](const std::pair<std::shared_ptr<Activation>, Solution> &a,
-                                     const std::pair<std::shared_ptr<Activation>, Solution> &b) {
-                return a.second.get_objective_value() < b.second.get_objective_value();
+        if (!candidate_order_.empty()) {
+            // Sorting elements, the ties in the order of the activations
+            std::sort(candidate_order_.begin(), candidate_order_.end(), [this](size_t a, size_t b) {
+                return candidates_[a].objective_value < candidates_[b].objective_value
+                       || (candidates_[a].objective_value == candidates_[b].objective_value && a < b);
             });
 
-            auto sol_size = static_cast<double>(avail_solutions.size());
+            auto sol_size = static_cast<double>(candidate_order_.size());
             auto upper_limit = std::min<size_t>(
                     static_cast<size_t>(std::ceil(sol_size * alpha_restrict_candidate_list_)),
-                    avail_solutions.size()) - 1ul;
+                    candidate_order_.size()) - 1ul;
 
             auto position = my_rand<size_t>(0ul, upper_limit);
 
-            auto selected_candidate = std::next(avail_solutions.begin(), static_cast<long>(position));
-            best_solution = selected_candidate->second;
+            auto selected = candidate_order_[position];
+            solution.Redo(candidates_[selected].move);
 
-            DLOG(INFO) << "Selected Activation from Restrict Candidate List[" << selected_candidate->first->get_id()
-                       << "]";
-            DLOG(INFO) << "Removing Activation[" << selected_candidate->first->get_id() << "]";
+            DLOG(INFO) << "Selected Activation from Restrict Candidate List["
+                       << candidates_[selected].activation->get_id() << "]";
+            DLOG(INFO) << "Removing Activation[" << candidates_[selected].activation->get_id() << "]";
 
             // Remove task scheduled
-            auto my_pos = std::find(avail_activations.begin(), avail_activations.end(),
-                                    selected_candidate->first);
-            avail_activations.erase(my_pos);
+            avail_activations.erase(avail_activations.begin() + static_cast<long>(selected));
         } else {
             LOG(FATAL) << "Something is strange";
         }
     }
 
     DLOG(INFO) << "... availed activations scheduled";
-    return best_solution;
 }
 
 /**
@@ -110,47 +116,30 @@ void Grch::Run() {
     auto number_of_iterations = 0ul;
     auto best_solution_iteration = 0ul;
     double best_solution_time;
+    std::vector<std::shared_ptr<Activation>> avail_activations;
+    Solution solution(shared_from_this());
     for (auto i = 0ul; i < std::numeric_limits<size_t>::max(); ++i) {
-        std::vector<std::shared_ptr<Activation>> activation_list;
-        std::vector<std::shared_ptr<Activation>> avail_activations;
-        Solution solution(shared_from_this());
-
-        // Start task list
-        DLOG(INFO) << "Initialize activation list";
-        for (const auto &activation: activations_) {
-            DLOG(INFO) << "Inserting activation " << activation->get_id();
-            activation_list.push_back(activation);
-        }
+        // Every iteration builds its solution on the buffers of the previous ones
+        solution.Reset();
 
-        // Order by height
-        DLOG(INFO) << "Order by height";
-        std::sort(activation_list.begin(), activation_list.end(),
-                  [&](const std::shared_ptr<Activation> &a, const std::shared_ptr<Activation> &b) {
-            return height_[a->get_id()] < height_[b->get_id()];
-        });
-
-        // The activation_list is sorted by the height(t). While activation_list is not empty do
+        // The levels hold the activations by height(t), computed once when the instance is loaded
         DLOG(INFO) << "Doing scheduling";
-        while (!activation_list.empty()) {
-            auto activation = activation_list.front();  // Get the first activation
-
+        for (size_t level = 0ul; level + 1ul < level_offsets_.size(); ++level) {
             /*
-             *  Gets the next available activations of the same height and shuffles them.
+             *  Gets the available activations of the same height and shuffles them.
              */
             avail_activations.clear();
-            while (!activation_list.empty()
-                   && height_[activation->get_id()] == height_[activation_list.front()->get_id()]) {
+            for (auto j = level_offsets_[level]; j < level_offsets_[level + 1ul]; ++j) {
                 // build list of ready tasks, that is the tasks which the predecessor was finish
-                DLOG(INFO) << "Putting " << activation_list.front()->get_id() << " in avail_activations";
-                avail_activations.push_back(activation_list.front());
-                activation_list.erase(activation_list.begin());
+                DLOG(INFO) << "Putting " << level_activations_[j] << " in avail_activations";
+                avail_activations.push_back(activations_[level_activations_[j]]);
             }
 
             DLOG(INFO) << "Shuffling activation list";
             std::shuffle(avail_activations.begin(), avail_activations.end(), generator());
 
             // Schedule the ready tasks (same height)
-            solution = ScheduleAvailTasks(avail_activations, solution);
+            ScheduleAvailTasks(avail_activations, solution);
         }
 
         DLOG(INFO) << "Scheduling done";
@@ -159,7 +148,7 @@ void Grch::Run() {
         number_of_iterations++;
         if (solution.get_objective_value() < best_solution.get_objective_value()) {
             iter_without_improve = 1ul;
-            best_solution = solution;
+            std::swap(best_solution, solution);
             best_solution_iteration = number_of_iterations;
             best_solution_time = time_s;
         } else {
@@ -28,8 +28,8 @@ public:
     ///
     virtual ~Grch() = default;
 
-    /// Schedule the avail task, one-by-one
-    Solution ScheduleAvailTasks(std::vector<std::shared_ptr<Activation>> avail_activations, Solution &solution);
+    /// Schedule the avail task, one-by-one, into \c solution; \c avail_activations ends empty
+    void ScheduleAvailTasks(std::vector<std::shared_ptr<Activation>> &avail_activations, Solution &solution);
 
     ///
     [[nodiscard]] std::string GetName() const override { return name_; }
@@ -37,7 +37,23 @@ public:
     ///
     void Run() override;
 private:
+    /// An activation of the restricted candidate list, with the move to its best VM
+    struct Candidate {
+        std::shared_ptr<Activation> activation;
+        double objective_value;
+        Solution::ScheduleMove move;
+    };
+
     std::string name_ = "grch";
+
+    /// The candidates of the last \c ScheduleAvailTasks(), kept so their moves keep their memory
+    std::vector<Candidate> candidates_;
+
+    /// The candidates sorted by their objective values
+    std::vector<size_t> candidate_order_;
+
+    /// The move being tried
+    Solution::ScheduleMove trial_move_;
 };
 
 
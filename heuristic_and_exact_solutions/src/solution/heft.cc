@@ -57,13 +57,12 @@ double Heft::CommunicationCostStatic(size_t activation_id, size_t vm_id) {
     // TODO: use the transfer file computation method
     auto cost = 0.0;
 
-    auto activation = activations_[activation_id];
+    const auto &activation = activations_[activation_id];
     auto target_vm = virtual_machines_[vm_id];
 
     for (const auto &file : activation->get_input_files()) {
-//        if (auto *static_file = dynamic_cast<StaticFile *>(file)) {
-        if (auto static_file = std::dynamic_pointer_cast<StaticFile>(file)) {
-            auto origin_vm = virtual_machines_[static_file->GetFirstVm()];
+        if (IsStaticFile(file->get_id())) {
+            auto origin_vm = virtual_machines_[GetStaticFileStorage(file->get_id())];
             auto bandwidth = std::min(origin_vm->get_bandwidth_in_GBps(), target_vm->get_bandwidth_in_GBps());
 
             // Calculate time
@@ -103,8 +102,8 @@ double Heft::CommunicationCostOfDynamicFiles(size_t activation_id_i,
         return 1.0;
     }
 
-    auto activation_i = activations_[activation_id_i];
-    auto activation_j = activations_[activation_id_j];
+    const auto &activation_i = activations_[activation_id_i];
+    const auto &activation_j = activations_[activation_id_j];
 
     auto vm_i = virtual_machines_[vm_id_i];
     auto vm_j = virtual_machines_[vm_id_j];
@@ -127,7 +126,7 @@ double Heft::CommunicationCostOfDynamicFiles(size_t activation_id_i,
 
     // Now, sum all the cost (in time) to transfer all those files
     for (auto file_id: common_files) {
-        auto file = files_[file_id];
+        const auto &file = files_[file_id];
         // TODO: Use the appropriated method
         cost += ceil(file->get_size_in_GB() / bandwidth);
     }
@@ -246,10 +245,7 @@ double Heft::RankUpward(size_t activation_id, std::vector<double> &communication
  * @return
  */
 double Heft::ComputationCost(size_t activation_id, size_t vm_id) {
-    // TODO: migrate this method to Algorithm class
-    auto task = activations_[activation_id];
-    auto vm = virtual_machines_[vm_id];
-    return ceil(task->get_time() * vm->get_slowdown());
+    return static_cast<double>(GetActivationRunTime(activation_id, vm_id));
 }
 
 /**
@@ -541,7 +537,7 @@ void Heft::Run() {
         auto events = pair_key_event.second;
 
         for (auto event : events) {
-            auto activation = activations_[event.id];
+            const auto &activation = activations_[event.id];
 
             DLOG(INFO) << "Allocating [" << activation->get_name() << "], [" << activation->get_id() << "], VM[" << vm_id << "]";
             auto vm = virtual_machines_[vm_id];
@@ -0,0 +1,77 @@
+/**
+ * \file src/solution/parse_benchmark.cc
+ * \brief Contains the \c ParseBenchmark class methods
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This source file contains the methods for the \c ParseBenchmark class that measures the
+ * throughput of the input file readers
+ */
+
+#include "src/solution/parse_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+
+DECLARE_string(tasks_and_files);
+DECLARE_string(cluster);
+DECLARE_string(conflict_graph);
+DECLARE_uint64(number_of_iteration);
+
+namespace {
+
+/// Print the throughput of parsing \c file_name in \c seconds, averaged over \c iterations
+void PrintThroughput(const std::string &file_name, double seconds, uint64_t iterations) {
+    auto bytes = static_cast<double>(std::filesystem::file_size(file_name));
+    std::ifstream in(file_name, std::ios::binary);
+    auto lines = static_cast<double>(std::count(std::istreambuf_iterator<char>(in),
+                                                std::istreambuf_iterator<char>(), '\n'));
+    auto average = seconds / static_cast<double>(iterations);
+
+    std::cout << std::fixed << std::setprecision(6)
+              << file_name << " " << average << " s "
+              << bytes / 1e6 / average << " MB/s "
+              << lines / average << " lines/s" << std::endl;
+}
+
+}  // namespace
+
+/**
+ * Reads the three text input files again, with a fresh \c ParseBenchmark each time, and prints the
+ * average time and throughput of every reader. Only the parsing is timed; the data derived from
+ * the instance afterwards is not.
+ */
+void ParseBenchmark::Run() {
+    using Clock = std::chrono::steady_clock;
+    auto iterations = std::max<uint64_t>(FLAGS_number_of_iteration, 1ul);
+    double tasks_and_files_time = 0.0;
+    double cluster_time = 0.0;
+    double conflict_graph_time = 0.0;
+
+    for (uint64_t i = 0ul; i < iterations; ++i) {
+        ParseBenchmark parser;
+
+        auto start = Clock::now();
+        parser.ReadTasksAndFiles(FLAGS_tasks_and_files);
+        auto tasks_and_files_end = Clock::now();
+        parser.ReadCluster(FLAGS_cluster);
+        auto cluster_end = Clock::now();
+        parser.ReadConflictGraph(FLAGS_conflict_graph);
+        auto conflict_graph_end = Clock::now();
+
+        tasks_and_files_time += std::chrono::duration<double>(tasks_and_files_end - start).count();
+        cluster_time += std::chrono::duration<double>(cluster_end - tasks_and_files_end).count();
+        conflict_graph_time += std::chrono::duration<double>(conflict_graph_end - cluster_end).count();
+    }
+
+    PrintThroughput(FLAGS_tasks_and_files, tasks_and_files_time, iterations);
+    PrintThroughput(FLAGS_cluster, cluster_time, iterations);
+    PrintThroughput(FLAGS_conflict_graph, conflict_graph_time, iterations);
+}
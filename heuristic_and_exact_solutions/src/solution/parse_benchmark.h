@@ -0,0 +1,40 @@
+/**
+ * \file src/solution/parse_benchmark.h
+ * \brief Contains the \c ParseBenchmark class declaration.
+ *
+ * \authors Rodrigo Alves Prado da Silva \<rodrigo.raps@gmail.com\>
+ * \copyright Fluminense Federal University (UFF)
+ * \copyright Computer Science Department
+ * \date 2024
+ *
+ * This header file contains the \c ParseBenchmark class that measures the throughput of the input
+ * file readers.
+ */
+
+#ifndef APPROXIMATE_SOLUTIONS_SRC_SOLUTION_PARSE_BENCHMARK_H_
+#define APPROXIMATE_SOLUTIONS_SRC_SOLUTION_PARSE_BENCHMARK_H_
+
+
+#include <string>
+
+#include "src/solution/algorithm.h"
+
+class ParseBenchmark : public Algorithm {
+public:
+    ///
+    ParseBenchmark() = default;
+
+    ///
+    virtual ~ParseBenchmark() = default;
+
+    ///
+    [[nodiscard]] std::string GetName() const override { return name_; }
+
+    /// Parse the text input files \c --number_of_iteration times and print the throughput
+    void Run() override;
+private:
+    std::string name_ = "parse_benchmark";
+};
+
+
+#endif  // APPROXIMATE_SOLUTIONS_SRC_SOLUTION_PARSE_BENCHMARK_H_